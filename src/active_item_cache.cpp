@@ -6,27 +6,33 @@
 #include "item.h"
 #include "safe_reference.h"
 
+int active_item_cache::period( int speed ) const
+{
+    const auto count = items_per_speed.find( speed );
+    return count == items_per_speed.end() ? speed : std::max( 1, std::min( speed, count->second ) );
+}
+
+void active_item_cache::forget( const scheduled_item &entry )
+{
+    const auto count = items_per_speed.find( entry.speed );
+    if( count != items_per_speed.end() && --count->second <= 0 ) {
+        items_per_speed.erase( count );
+    }
+}
+
 void active_item_cache::remove( const item *it )
 {
-    for( auto &list : active_items ) {
-        int count = 0;
-        list.second.second.erase( std::remove_if( list.second.second.begin(),
-        list.second.second.end(), [it, &count, &list]( const cache_reference<item> &active_item ) {
-            if( !active_item ) {
-                count++;
+    for( auto bucket = schedule.begin(); bucket != schedule.end(); ) {
+        std::vector<scheduled_item> &due = bucket->second;
+        due.erase( std::remove_if( due.begin(), due.end(),
+        [this, it]( const scheduled_item & entry ) {
+            if( !entry.item_ref || &*entry.item_ref == it ) {
+                forget( entry );
                 return true;
             }
-            item *const target = &*active_item;
-            if( !target || target == it ) {
-                if( count >= list.second.first ) {
-                    list.second.first = std::max( 0, list.second.first - 1 );
-                }
-                count++;
-                return true;
-            }
-            count++;
             return false;
-        } ), list.second.second.end() );
+        } ), due.end() );
+        bucket = due.empty() ? schedule.erase( bucket ) : std::next( bucket );
     }
     if( it->can_revive() ) {
         std::vector<cache_reference<item>> &corpse = special_items[ special_item_type::corpse ];
@@ -41,9 +47,12 @@ void active_item_cache::remove( const item *it )
 void active_item_cache::add( item &it )
 {
     // If the item is alread in the cache for some reason, don't add a second reference
-    std::vector<cache_reference<item>> &target_list = active_items[it.processing_speed()].second;
-    if( std::find( target_list.begin(), target_list.end(), it ) != target_list.end() ) {
-        return;
+    for( const auto &bucket : schedule ) {
+        for( const scheduled_item &entry : bucket.second ) {
+            if( entry.item_ref == it ) {
+                return;
+            }
+        }
     }
     if( it.can_revive() ) {
         special_items[ special_item_type::corpse ].emplace_back( it );
@@ -51,71 +60,53 @@ void active_item_cache::add( item &it )
     if( it.get_use( "explosion" ) ) {
         special_items[ special_item_type::explosive ].emplace_back( it );
     }
-    target_list.emplace_back( it );
+    const int speed = it.processing_speed();
+    items_per_speed[speed]++;
+    const int first_period = period( speed );
+    const int spread = first_period > 1 ? static_cast<int>( next_spread++ % first_period ) : 0;
+    schedule[ticks + 1 + spread].push_back( scheduled_item{ cache_reference<item>( it ), speed } );
 }
 
 bool active_item_cache::empty() const
 {
-    return std::all_of( active_items.begin(), active_items.end(), []( const auto & active_queue ) {
-        return active_queue.second.second.empty();
-    } );
+    return schedule.empty();
 }
 
 std::vector<item *> active_item_cache::get()
 {
     std::vector<item *> all_cached_items;
-    for( std::pair<const int, std::pair<int, std::vector<cache_reference<item>>>> &kv : active_items ) {
-        for( std::vector<cache_reference<item>>::iterator it = kv.second.second.begin();
-             it != kv.second.second.end(); ) {
-            if( *it ) {
-                all_cached_items.push_back( & **it );
+    for( auto bucket = schedule.begin(); bucket != schedule.end(); ) {
+        std::vector<scheduled_item> &due = bucket->second;
+        for( auto it = due.begin(); it != due.end(); ) {
+            if( it->item_ref ) {
+                all_cached_items.push_back( & *it->item_ref );
                 ++it;
             } else {
-                it = kv.second.second.erase( it );
+                forget( *it );
+                it = due.erase( it );
             }
         }
+        bucket = due.empty() ? schedule.erase( bucket ) : std::next( bucket );
     }
     return all_cached_items;
 }
 
 std::vector<item *> active_item_cache::get_for_processing()
 {
+    ++ticks;
     std::vector<item *> items_to_process;
-    for( std::pair < const int, std::pair<int, std::vector<cache_reference<item>>>> &kv :
-         active_items ) {
-        //The algorithm here is a bit weird. We're going to process a fraction of the list at a time, keeping track of where we are in the list with a simple int.
-        //But, the list could change between each run. As such the number will be reduced when items are removed from it (in ::remove) to prevent skips.
-
-        if( kv.second.second.empty() ) { //Prevents a div by 0 in the modulo operations
-            kv.second.first = 0; //May as well reset the position
-            continue;
-        }
-
-        // Rely on iteration logic to make sure the number is sane.
-        int num_to_process = std::max( 1, static_cast<int>( kv.second.second.size() / kv.first ) );
-        std::vector<cache_reference<item>>::iterator it = kv.second.second.begin();
-
-
-        kv.second.first = kv.second.first %
-                          kv.second.second.size(); //Make sure the key isn't larger than the array
-        std::advance( it, kv.second.first );
-
-        kv.second.first += num_to_process + 1;
-        while( num_to_process > 0 ) {
-            if( *it ) {
-                items_to_process.push_back( & **it );
-                --num_to_process;
-                ++it;
-            } else {
-                // The item has been destroyed, so remove the reference from the cache
-                it = kv.second.second.erase( it );
-                if( kv.second.second.empty() ) {
-                    break;
-                }
-            }
-            if( it == kv.second.second.end() ) {
-                it = kv.second.second.begin();
+    while( !schedule.empty() && schedule.begin()->first <= ticks ) {
+        std::vector<scheduled_item> due = std::move( schedule.begin()->second );
+        schedule.erase( schedule.begin() );
+        for( scheduled_item &entry : due ) {
+            // Destroyed items are just not scheduled again
+            if( !entry.item_ref ) {
+                forget( entry );
+                continue;
             }
+            items_to_process.push_back( &*entry.item_ref );
+            const int next = ticks + period( entry.speed );
+            schedule[next].push_back( std::move( entry ) );
         }
     }
     return items_to_process;
@@ -2,6 +2,7 @@
 
 #include <iosfwd>
 #include <list>
+#include <map>
 #include <unordered_map>
 #include <vector>
 
@@ -29,20 +30,39 @@ struct hash<special_item_type> {
 class active_item_cache
 {
     private:
-        std::unordered_map<int, std::pair<int, std::vector<cache_reference<item>>>> active_items;
+        struct scheduled_item {
+            cache_reference<item> item_ref;
+            // item::processing_speed() of the item, kept so it's known after the item is destroyed
+            int speed;
+        };
+        // Items waiting to be processed, bucketed by the tick they are next due on
+        std::map<int, std::vector<scheduled_item>> schedule;
+        // Number of items in the cache for each processing speed
+        std::unordered_map<int, int> items_per_speed;
+        // Number of calls to get_for_processing so far
+        int ticks = 0;
+        // Offsets the first tick of slow items, so that the ones added together (like when a
+        // submap is loaded) don't all come due on the same tick
+        unsigned int next_spread = 0;
         std::unordered_map<special_item_type, std::vector<cache_reference<item>>> special_items;
 
+        /**
+         * Ticks between two runs of an item with processing speed @p speed. That is the speed,
+         * unless there are fewer items with it than that: at least one of them runs every tick.
+         */
+        int period( int speed ) const;
+        void forget( const scheduled_item &entry );
+
     public:
         /**
          * Removes the item if it is in the cache. Does nothing if the item is not in the cache.
-         * Relies on the fact that item::processing_speed() is a constant.
          * Also removes any items that have been destroyed in the list containing it
          */
         void remove( const item *it );
 
         /**
          * Adds the reference to the cache. Does nothing if the reference is already in the cache.
-         * Relies on the fact that item::processing_speed() is a constant.
+         * The item is first due on the next tick, or for slow items within their processing speed.
          */
         void add( item &it );
 
@@ -58,9 +78,12 @@ class active_item_cache
         std::vector<item *> get();
 
         /**
-         * Returns the first size() / processing_speed() elements of each list, rounded up.
-         * Items returned are rotated to the back of their respective lists, otherwise only the
-         * first n items will ever be processed.
+         * Advances the cache by one tick and returns the items due on it, which are then
+         * scheduled again item::processing_speed() ticks later. Items are only looked at when
+         * they are due, so slow items cost nothing on the ticks in between.
+         * As long as there are fewer items of a speed than that speed, they are scheduled sooner,
+         * so that at least one of them is processed on each tick. A lone corpse is still checked
+         * for revival every tick.
          * Broken references encountered when collecting the items to be processed are removed from
          * the cache.
          * Relies on the fact that item::processing_speed() is a constant.
@@ -72,4 +95,3 @@ class active_item_cache
          */
         std::vector<item *> get_special( special_item_type type );
 };
-
@@ -23,7 +23,7 @@ class mission;
 class monster;
 class npc;
 class map_memory;
-struct memorized_terrain_tile;
+struct mm_packed_tile;
 
 namespace debug_menu
 {
@@ -94,11 +94,12 @@ class avatar : public player
         void toggle_map_memory();
         bool should_show_map_memory();
         void prepare_map_memory_region( const tripoint &p1, const tripoint &p2 );
+        const map_memory &get_map_memory() const;
         /** Memorizes a given tile in tiles mode; finalize_tile_memory needs to be called after it */
         void memorize_tile( const tripoint &pos, const std::string &ter, int subtile,
                             int rotation );
         /** Returns last stored map tile in given location in tiles mode */
-        const memorized_terrain_tile &get_memorized_tile( const tripoint &p ) const;
+        mm_packed_tile get_memorized_tile( const tripoint &p ) const;
         /** Memorizes a given tile in curses mode; finalize_terrain_memory_curses needs to be called after it */
         void memorize_symbol( const tripoint &pos, int symbol );
         /** Returns last stored map tile in given location in curses mode */
@@ -0,0 +1,53 @@
+#include "binary_io.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "string_formatter.h"
+
+namespace cata
+{
+
+uint64_t binary_reader::read_varint()
+{
+    uint64_t value = 0;
+    for( int shift = 0; shift < 64; shift += 7 ) {
+        if( pos >= data.size() ) {
+            fail( "unexpected end of data" );
+        }
+        const uint8_t byte = static_cast<uint8_t>( data[pos++] );
+        value |= static_cast<uint64_t>( byte & 0x7f ) << shift;
+        if( !( byte & 0x80 ) ) {
+            return value;
+        }
+    }
+    fail( "varint too long" );
+}
+
+std::string_view binary_reader::read_string()
+{
+    const uint64_t size = read_varint();
+    if( size > data.size() - pos ) {
+        fail( "string runs past end of data" );
+    }
+    const std::string_view result = data.substr( pos, size );
+    pos += size;
+    return result;
+}
+
+bool binary_reader::read_and_compare( const void *expected, size_t size )
+{
+    if( size > data.size() - pos ) {
+        return false;
+    }
+    const bool same = std::memcmp( data.data() + pos, expected, size ) == 0;
+    pos += size;
+    return same;
+}
+
+void binary_reader::fail( const char *what ) const
+{
+    throw std::runtime_error( string_format( "binary data corrupt at byte %d: %s", pos, what ) );
+}
+
+} // namespace cata
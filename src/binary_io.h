@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * Minimal helpers for compact binary save data.
+ *
+ * Integers are stored as LEB128 varints (signed ones zigzag-encoded first), strings
+ * as a varint length followed by the raw bytes. There is no self-description, so
+ * readers and writers have to agree on the layout, and any layout change needs a
+ * version bump in whatever header the caller writes.
+ */
+namespace cata
+{
+
+class binary_writer
+{
+    public:
+        void write_varint( uint64_t value ) {
+            while( value >= 0x80 ) {
+                buf.push_back( static_cast<char>( ( value & 0x7f ) | 0x80 ) );
+                value >>= 7;
+            }
+            buf.push_back( static_cast<char>( value ) );
+        }
+        void write_signed( int64_t value ) {
+            write_varint( ( static_cast<uint64_t>( value ) << 1 ) ^ static_cast<uint64_t>( value >> 63 ) );
+        }
+        void write_string( std::string_view str ) {
+            write_varint( str.size() );
+            buf.append( str );
+        }
+        void write_bytes( const void *data, size_t size ) {
+            buf.append( static_cast<const char *>( data ), size );
+        }
+
+        const std::string &data() const {
+            return buf;
+        }
+
+    private:
+        std::string buf;
+};
+
+/**
+ * Reads what @ref binary_writer wrote. Throws std::runtime_error when the data
+ * ends early or a value is malformed.
+ */
+class binary_reader
+{
+    public:
+        explicit binary_reader( std::string_view data ) : data( data ) {}
+
+        uint64_t read_varint();
+        int64_t read_signed() {
+            const uint64_t raw = read_varint();
+            return static_cast<int64_t>( raw >> 1 ) ^ -static_cast<int64_t>( raw & 1 );
+        }
+        std::string_view read_string();
+        /** Reads @p size bytes and checks they match @p expected. */
+        bool read_and_compare( const void *expected, size_t size );
+
+        bool eof() const {
+            return pos >= data.size();
+        }
+
+    private:
+        [[noreturn]] void fail( const char *what ) const;
+
+        std::string_view data;
+        size_t pos = 0;
+};
+
+} // namespace cata
+
@@ -59,6 +59,12 @@ extern bool fov_3d;
 /** 3D FoV range, in Z levels, in both directions. */
 extern int fov_3d_z_range;
 
+/** Build the per z-level outside and transparency caches on the thread pool. */
+extern bool parallel_map_cache;
+
+/** Pick where gas fields spread to on the thread pool, applying the spreads per z-level. */
+extern bool parallel_field_spread;
+
 /** Using isometric tileset. */
 extern bool tile_iso;
 
@@ -85,6 +91,13 @@ extern int PICKUP_RANGE;
  */
 extern bool dont_debugmsg;
 
+/**
+ * Skip the consistency checks of game data that this version of the game already checked
+ * without errors, see PATH_INFO::verified_data and init::data_fingerprint.
+ * Only the checks are skipped: the data is still loaded and finalized from JSON every time.
+ */
+extern bool skip_verified_data_checks;
+
 
 /* Options related to fungal activity */
 struct FungalOptions {
@@ -344,6 +344,8 @@ void cata_tiles::load_tileset(
     const bool pump_events
 )
 {
+    // This is also called after the game data is finalized, when int ids may have changed
+    tile_handles.clear();
     if( !force && tileset_ptr &&
         !get_option<bool>( "FORCE_TILESET_RELOAD" ) &&
         tileset_ptr->get_tileset_id() == tileset_id &&
@@ -1323,6 +1325,12 @@ void cata_tiles::draw( point dest, const tripoint &center, int width, int height
         return;
     }
 
+    const season_type season = season_of_year( calendar::turn );
+    if( tile_handles.season != season ) {
+        tile_handles.clear();
+        tile_handles.season = season;
+    }
+
 #if defined(__ANDROID__)
     // Attempted bugfix for Google Play crash - prevent divide-by-zero if no tile width/height specified
     if( tile_width == 0 || tile_height == 0 ) {
@@ -1977,6 +1985,12 @@ bool cata_tiles::draw_from_id_string( const std::string &id, const tripoint &pos
                                             ll, apply_night_vision_goggles, nullint, overlay_count );
 }
 
+static bool is_immovable_furniture( const std::string &found_id )
+{
+    const furn_str_id fid( found_id );
+    return fid.is_valid() && !fid.obj().is_movable();
+}
+
 bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY category,
                                       const std::string &subcategory, const tripoint &pos,
                                       int subtile, int rota, lit_level ll, bool apply_night_vision_goggles, int overlay_count )
@@ -2164,10 +2178,8 @@ bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY categ
         return false;
     }
 
-    const tile_type *tt = search_result.value().tt;
-    std::string found_id = search_result.value().found_id;
-
-    const tile_type &display_tile = *tt;
+    const tile_type &display_tile = *search_result->tt;
+    const std::string &found_id = search_result->found_id;
     // check to see if the display_tile is multitile, and if so if it has the key related to subtile
     if( subtile != -1 && display_tile.multitile ) {
         const auto &display_subtiles = display_tile.available_subtiles;
@@ -2180,6 +2192,102 @@ bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY categ
         }
     }
 
+    const resolved_tile tile{ *search_result, category == C_FURNITURE && is_immovable_furniture( found_id ) };
+    return draw_resolved_tile( tile, category, pos, rota, ll, apply_night_vision_goggles, height_3d,
+                               overlay_count, as_independent_entity );
+}
+
+void tile_handle_cache::clear()
+{
+    terrain.clear();
+    furniture.clear();
+    traps.clear();
+    fields.clear();
+    vparts.clear();
+    monsters.clear();
+    items.clear();
+    corpses.clear();
+    season.reset();
+}
+
+template<typename T>
+static tile_handle &tile_handle_for( std::vector<tile_handle> &handles, const int_id<T> &id )
+{
+    const size_t index = id.to_i();
+    if( index >= handles.size() ) {
+        handles.resize( index + 1 );
+    }
+    return handles[index];
+}
+
+void cata_tiles::resolve_tile_handle( tile_handle &handle, const std::string &id,
+                                      TILE_CATEGORY category, const std::string &subcategory, int subtile, int rota )
+{
+    handle.resolved = true;
+    // Only the ASCII fallback of vehicle parts depends on their subtile and rotation
+    handle.cacheable = category != C_VEHICLE_PART || find_tile_looks_like( id, category );
+    if( !handle.cacheable ) {
+        return;
+    }
+    const std::optional<tile_search_result> found = tile_type_search( id, category, subcategory,
+            subtile, rota );
+    if( !found ) {
+        return;
+    }
+    handle.base = resolved_tile{ *found, category == C_FURNITURE && is_immovable_furniture( found->found_id ) };
+    const tile_type &base_tile = *found->tt;
+    if( !base_tile.multitile ) {
+        return;
+    }
+    for( size_t i = 0; i < multitile_keys.size(); ++i ) {
+        const auto &available = base_tile.available_subtiles;
+        if( std::find( available.begin(), available.end(), multitile_keys[i] ) == available.end() ) {
+            continue;
+        }
+        const std::string subtile_id = found->found_id + "_" + multitile_keys[i];
+        const std::optional<tile_search_result> found_subtile = tile_type_search( subtile_id, category,
+                subcategory, -1, rota );
+        if( found_subtile ) {
+            handle.subtiles[i] = resolved_tile{ *found_subtile, category == C_FURNITURE &&
+                                                is_immovable_furniture( found_subtile->found_id ) };
+        }
+    }
+}
+
+bool cata_tiles::draw_from_tile_handle( tile_handle &handle, const std::string &id,
+                                        TILE_CATEGORY category, const std::string &subcategory, const tripoint &pos,
+                                        int subtile, int rota, lit_level ll, bool apply_night_vision_goggles, int &height_3d,
+                                        int overlay_count )
+{
+    half_open_rectangle<point> screen_bounds( o, o + point( screentile_width, screentile_height ) );
+    if( !tile_iso && !screen_bounds.contains( pos.xy() ) ) {
+        return false;
+    }
+    if( !handle.resolved ) {
+        resolve_tile_handle( handle, id, category, subcategory, subtile, rota );
+    }
+    if( !handle.cacheable ) {
+        return draw_from_id_string( id, category, subcategory, pos, subtile, rota, ll,
+                                    apply_night_vision_goggles, height_3d, overlay_count );
+    }
+    if( !handle.base ) {
+        return false;
+    }
+    const resolved_tile *tile = &*handle.base;
+    if( subtile != -1 && tile->found.tt->multitile && handle.subtiles[subtile] ) {
+        tile = &*handle.subtiles[subtile];
+    }
+    return draw_resolved_tile( *tile, category, pos, rota, ll, apply_night_vision_goggles, height_3d,
+                               overlay_count, false );
+}
+
+bool cata_tiles::draw_resolved_tile( const resolved_tile &tile, TILE_CATEGORY category,
+                                     const tripoint &pos, int rota, lit_level ll, bool apply_night_vision_goggles,
+                                     int &height_3d, int overlay_count, const bool as_independent_entity )
+{
+    const tile_type &display_tile = *tile.found.tt;
+    const std::string &found_id = tile.found.found_id;
+
     // translate from player-relative to screen relative tile position
     const point screen_pos = as_independent_entity ? pos.xy() : player_to_screen( pos.xy() );
 
@@ -2237,12 +2345,8 @@ bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY categ
             // since we won't get the behavior that occurs where the tile constantly
             // changes when the player grabs the furniture and drags it, causing the
             // seed to change.
-            const furn_str_id fid( found_id );
-            if( fid.is_valid() ) {
-                const furn_t &f = fid.obj();
-                if( !f.is_movable() ) {
-                    seed = simple_point_hash( here.getabs( pos ) );
-                }
+            if( tile.immovable_furniture ) {
+                seed = simple_point_hash( here.getabs( pos ) );
             }
         }
         break;
@@ -2668,8 +2772,8 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
             if( t == t_open_air ) {
                 return draw_block( p, curses_color_to_SDL( c_cyan ), 4 );
             } else {
-                return draw_from_id_string( tname, C_TERRAIN, empty_string, p, subtile, rotation, ll,
-                                            nv_goggles_activated, height_3d, z_drop );
+                return draw_from_tile_handle( tile_handle_for( tile_handles.terrain, t ), tname, C_TERRAIN,
+                                              empty_string, p, subtile, rotation, ll, nv_goggles_activated, height_3d, z_drop );
             }
         }
     }
@@ -2692,14 +2796,14 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( tname, C_TERRAIN, empty_string, p, subtile, rotation, lit, nv,
-                                        height_3d, z_drop );
+            return draw_from_tile_handle( tile_handle_for( tile_handles.terrain, t2 ), tname, C_TERRAIN,
+                                          empty_string, p, subtile, rotation, lit, nv, height_3d, z_drop );
         }
     } else if( invisible[0] && has_terrain_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const auto &t = get_terrain_memory_at( p );
 
-        return draw_from_id_string( t.tile, C_TERRAIN, empty_string, p, t.subtile, t.rotation,
+        return draw_from_id_string( t.name(), C_TERRAIN, empty_string, p, t.subtile, t.rotation,
                                     lit_level::MEMORIZED, nv_goggles_activated, height_3d, z_drop );
     }
     return false;
@@ -2708,8 +2812,8 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
 bool cata_tiles::has_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        return !t.tile.empty();
+        const mm_packed_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        return !t.name().empty();
     }
     return false;
 }
@@ -2717,8 +2821,8 @@ bool cata_tiles::has_memory_at( const tripoint &p ) const
 bool cata_tiles::has_terrain_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "t_" ) ) {
+        const mm_packed_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        if( t.name().starts_with( "t_" ) ) {
             return true;
         }
     }
@@ -2728,8 +2832,8 @@ bool cata_tiles::has_terrain_memory_at( const tripoint &p ) const
 bool cata_tiles::has_furniture_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "f_" ) ) {
+        const mm_packed_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        if( t.name().starts_with( "f_" ) ) {
             return true;
         }
     }
@@ -2739,8 +2843,8 @@ bool cata_tiles::has_furniture_memory_at( const tripoint &p ) const
 bool cata_tiles::has_trap_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "tr_" ) ) {
+        const mm_packed_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        if( t.name().starts_with( "tr_" ) ) {
             return true;
         }
     }
@@ -2750,52 +2854,52 @@ bool cata_tiles::has_trap_memory_at( const tripoint &p ) const
 bool cata_tiles::has_vpart_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "vp_" ) ) {
+        const mm_packed_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        if( t.name().starts_with( "vp_" ) ) {
             return true;
         }
     }
     return false;
 }
 
-memorized_terrain_tile cata_tiles::get_terrain_memory_at( const tripoint &p ) const
+mm_packed_tile cata_tiles::get_terrain_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "t_" ) ) {
+        const mm_packed_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        if( t.name().starts_with( "t_" ) ) {
             return t;
         }
     }
     return {};
 }
 
-memorized_terrain_tile cata_tiles::get_furniture_memory_at( const tripoint &p ) const
+mm_packed_tile cata_tiles::get_furniture_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "f_" ) ) {
+        const mm_packed_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        if( t.name().starts_with( "f_" ) ) {
             return t;
         }
     }
     return {};
 }
 
-memorized_terrain_tile cata_tiles::get_trap_memory_at( const tripoint &p ) const
+mm_packed_tile cata_tiles::get_trap_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "tr_" ) ) {
+        const mm_packed_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        if( t.name().starts_with( "tr_" ) ) {
             return t;
         }
     }
     return {};
 }
 
-memorized_terrain_tile cata_tiles::get_vpart_memory_at( const tripoint &p ) const
+mm_packed_tile cata_tiles::get_vpart_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "vp_" ) ) {
+        const mm_packed_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        if( t.name().starts_with( "vp_" ) ) {
             return t;
         }
     }
@@ -2842,8 +2946,8 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
         }
         // draw the actual furniture if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( fname, C_FURNITURE, empty_string, p, subtile, rotation, ll,
-                                        nv_goggles_activated, height_3d, z_drop );
+            return draw_from_tile_handle( tile_handle_for( tile_handles.furniture, f ), fname, C_FURNITURE,
+                                          empty_string, p, subtile, rotation, ll, nv_goggles_activated, height_3d, z_drop );
         }
     }
     if( invisible[0] ? overridden : neighborhood_overridden ) {
@@ -2879,13 +2983,13 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( fname, C_FURNITURE, empty_string, p, subtile, rotation, lit, nv,
-                                        height_3d, z_drop );
+            return draw_from_tile_handle( tile_handle_for( tile_handles.furniture, f2 ), fname, C_FURNITURE,
+                                          empty_string, p, subtile, rotation, lit, nv, height_3d, z_drop );
         }
     } else if( invisible[0] && has_furniture_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const auto &t = get_furniture_memory_at( p );
-        return draw_from_id_string( t.tile, C_FURNITURE, empty_string, p, t.subtile, t.rotation,
+        return draw_from_id_string( t.name(), C_FURNITURE, empty_string, p, t.subtile, t.rotation,
                                     lit_level::MEMORIZED, nv_goggles_activated, height_3d, z_drop );
     }
     return false;
@@ -2925,8 +3029,8 @@ bool cata_tiles::draw_trap( const tripoint &p, const lit_level ll, int &height_3
         }
         // draw the actual trap if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( trname, C_TRAP, empty_string, p, subtile, rotation, ll,
-                                        nv_goggles_activated, height_3d, z_drop );
+            return draw_from_tile_handle( tile_handle_for( tile_handles.traps, tr ), trname, C_TRAP,
+                                          empty_string, p, subtile, rotation, ll, nv_goggles_activated, height_3d, z_drop );
         }
     }
     if( overridden || ( !invisible[0] && neighborhood_overridden && tr.obj().can_see( p, g->u ) ) ) {
@@ -2954,13 +3058,13 @@ bool cata_tiles::draw_trap( const tripoint &p, const lit_level ll, int &height_3
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( trname, C_TRAP, empty_string, p, subtile, rotation, lit, nv,
-                                        height_3d, z_drop );
+            return draw_from_tile_handle( tile_handle_for( tile_handles.traps, tr2 ), trname, C_TRAP,
+                                          empty_string, p, subtile, rotation, lit, nv, height_3d, z_drop );
         }
     } else if( invisible[0] && has_trap_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const auto &t = get_trap_memory_at( p );
-        return draw_from_id_string( t.tile, C_TRAP, empty_string, p, t.subtile, t.rotation,
+        return draw_from_id_string( t.name(), C_TRAP, empty_string, p, t.subtile, t.rotation,
                                     lit_level::MEMORIZED, nv_goggles_activated, height_3d, z_drop );
     }
     return false;
@@ -3013,8 +3117,11 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, const lit_level ll, int
         int rotation = 0;
         get_tile_values( fld.to_i(), neighborhood, subtile, rotation );
 
-        ret_draw_field = draw_from_id_string( fld.id().str(), C_FIELD, empty_string, p, subtile,
-                                              rotation, lit, nv, z_drop );
+        // fields don't raise the sprites drawn on top of them
+        int field_height_3d = 0;
+        ret_draw_field = draw_from_tile_handle( tile_handle_for( tile_handles.fields, fld ),
+                                                fld.id().str(), C_FIELD, empty_string, p, subtile, rotation, lit, nv, field_height_3d,
+                                                z_drop );
     }
     if( fld.obj().display_items ) {
         const auto it_override = item_override.find( p );
@@ -3041,14 +3148,19 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, const lit_level ll, int
             it_type = nullptr;
         }
         if( it_type && !it_id.is_null() ) {
-            const std::string disp_id = it_id == itype_corpse && mon_id ?
-                                        "corpse_" + mon_id.str() : it_id.str();
-            const std::string it_category = it_type->get_item_type_string();
+            const bool is_corpse = it_id == itype_corpse && mon_id;
+            tile_handle &handle = is_corpse ? tile_handles.corpses[mon_id] : tile_handles.items[it_id];
             const lit_level lit = it_overridden ? lit_level::LIT : ll;
             const bool nv = it_overridden ? false : nv_goggles_activated;
 
-            ret_draw_items = draw_from_id_string( disp_id, C_ITEM, it_category, p, 0, 0, lit,
-                                                  nv, height_3d, z_drop );
+            if( handle.resolved && handle.cacheable ) {
+                ret_draw_items = draw_from_tile_handle( handle, empty_string, C_ITEM, empty_string, p, 0, 0,
+                                                        lit, nv, height_3d, z_drop );
+            } else {
+                const std::string disp_id = is_corpse ? "corpse_" + mon_id.str() : it_id.str();
+                ret_draw_items = draw_from_tile_handle( handle, disp_id, C_ITEM,
+                                                        it_type->get_item_type_string(), p, 0, 0, lit, nv, height_3d, z_drop );
+            }
             if( ret_draw_items && hilite ) {
                 draw_item_highlight( p );
             }
@@ -3076,17 +3188,21 @@ bool cata_tiles::draw_vpart( const tripoint &p, lit_level ll, int &height_3d,
         const vpart_id &vp_id = veh.part_id_string( veh_part, z_drop > 0 && critter == nullptr, part_mod );
         const int subtile = part_mod == 1 ? open_ : part_mod == 2 ? broken : 0;
         const int rotation = std::round( to_degrees( veh.face.dir() ) );
-        const std::string vpname = "vp_" + vp_id.str();
+        tile_handle &handle = tile_handles.vparts[vp_id];
         avatar &you = get_avatar();
-        if( !veh.forward_velocity() && !veh.player_in_control( you ) &&
-            here.check_seen_cache( p ) ) {
+        const bool memorize = !veh.forward_velocity() && !veh.player_in_control( you ) &&
+                              here.check_seen_cache( p );
+        // the tile id is only needed until the handle has been resolved
+        const std::string vpname = memorize || !handle.resolved || !handle.cacheable ?
+                                   "vp_" + vp_id.str() : std::string();
+        if( memorize ) {
             you.memorize_tile( here.getabs( p ), vpname, subtile, rotation );
         }
         if( !overridden ) {
             const std::optional<vpart_reference> cargopart = vp.part_with_feature( "CARGO", true );
             const bool draw_highlight = cargopart && !veh.get_items( cargopart->part_index() ).empty();
-            const bool ret = draw_from_id_string( vpname, C_VEHICLE_PART, empty_string, p, subtile, rotation,
-                                                  ll, nv_goggles_activated, height_3d, z_drop );
+            const bool ret = draw_from_tile_handle( handle, vpname, C_VEHICLE_PART, empty_string, p,
+                                                    subtile, rotation, ll, nv_goggles_activated, height_3d, z_drop );
             if( ret && draw_highlight ) {
                 draw_item_highlight( p );
             }
@@ -3104,9 +3220,9 @@ bool cata_tiles::draw_vpart( const tripoint &p, lit_level ll, int &height_3d,
             const std::string vpname = "vp_" + vp2.str();
             // tile overrides are never memorized
             // tile overrides are always shown with full visibility
-            const bool ret = draw_from_id_string( vpname, C_VEHICLE_PART, empty_string, p,
-                                                  subtile, to_degrees( rotation ), lit_level::LIT,
-                                                  false, height_3d, z_drop );
+            const bool ret = draw_from_tile_handle( tile_handles.vparts[vp2], vpname, C_VEHICLE_PART,
+                                                    empty_string, p, subtile, to_degrees( rotation ), lit_level::LIT, false, height_3d,
+                                                    z_drop );
             if( ret && draw_highlight ) {
                 draw_item_highlight( p );
             }
@@ -3115,7 +3231,7 @@ bool cata_tiles::draw_vpart( const tripoint &p, lit_level ll, int &height_3d,
     } else if( invisible[0] && has_vpart_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const auto &t = get_vpart_memory_at( p );
-        return draw_from_id_string( t.tile, C_VEHICLE_PART, empty_string, p, t.subtile, t.rotation,
+        return draw_from_id_string( t.name(), C_VEHICLE_PART, empty_string, p, t.subtile, t.rotation,
                                     lit_level::MEMORIZED, nv_goggles_activated, height_3d, z_drop );
     }
     return false;
@@ -3143,8 +3259,8 @@ bool cata_tiles::draw_critter_at( const tripoint &p, lit_level ll, int &height_3
         const std::string &chosen_id = id.str();
         const std::string &ent_subcategory = id.obj().species.empty() ?
                                              empty_string : id.obj().species.begin()->str();
-        result = draw_from_id_string( chosen_id, C_MONSTER, ent_subcategory, p, corner, 0,
-                                      lit_level::LIT, false, height_3d, z_drop );
+        result = draw_from_tile_handle( tile_handles.monsters[id], chosen_id, C_MONSTER, ent_subcategory,
+                                        p, corner, 0, lit_level::LIT, false, height_3d, z_drop );
     } else if( !invisible[0] ) {
         const Creature *pcritter = g->critter_at( p, true );
         if( pcritter == nullptr ) {
@@ -3181,6 +3297,7 @@ bool cata_tiles::draw_critter_at( const tripoint &p, lit_level ll, int &height_3
             if( rot_facing >= 0 ) {
                 const auto ent_name = m->type->id;
                 std::string chosen_id = ent_name.str();
+                bool ridden = false;
                 if( m->has_effect( effect_ridden ) ) {
                     int pl_under_height = 6;
                     if( m->mounted_player ) {
@@ -3192,10 +3309,16 @@ bool cata_tiles::draw_critter_at( const tripoint &p, lit_level ll, int &height_3
                     const tile_type *tt = tileset_ptr->find_tile_type( ridden_id );
                     if( tt ) {
                         chosen_id = ridden_id;
+                        ridden = true;
                     }
                 }
-                result = draw_from_id_string( chosen_id, ent_category, ent_subcategory, p, subtile, rot_facing,
-                                              ll, false, height_3d, z_drop );
+                if( ridden ) {
+                    result = draw_from_id_string( chosen_id, ent_category, ent_subcategory, p, subtile,
+                                                  rot_facing, ll, false, height_3d, z_drop );
+                } else {
+                    result = draw_from_tile_handle( tile_handles.monsters[ent_name], chosen_id, ent_category,
+                                                    ent_subcategory, p, subtile, rot_facing, ll, false, height_3d, z_drop );
+                }
                 sees_player = m->sees( g->u );
                 attitude = m->attitude_to( g-> u );
             }
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -350,6 +352,49 @@ struct tile_search_result {
     std::string found_id;
 };
 
+/** A tile found for a game object, with what is needed to pick its sprite variant. */
+struct resolved_tile {
+    tile_search_result found;
+    /** Furniture that can't be dragged around, its sprite variant is picked by position */
+    bool immovable_furniture = false;
+};
+
+/**
+ * The tiles drawing a game object would look up by string id, resolved on first use
+ * and kept until the tileset or the season changes.
+ */
+struct tile_handle {
+    bool resolved = false;
+    /**
+     * False if the lookup depends on more than the object, e.g. the ASCII fallback of a
+     * vehicle part depends on its rotation. Such objects are always looked up by string.
+     */
+    bool cacheable = true;
+    /** nullopt if nothing can be drawn for the object */
+    std::optional<resolved_tile> base;
+    /** Tile of each multitile subtile the base tile has, indexed like the multitile keys */
+    std::array<std::optional<resolved_tile>, 8> subtiles;
+};
+
+/**
+ * Tile handles of the game objects drawn on the map. Objects with int ids get a flat
+ * array indexed by that id, the others are keyed by their interned string id.
+ */
+struct tile_handle_cache {
+    std::vector<tile_handle> terrain;
+    std::vector<tile_handle> furniture;
+    std::vector<tile_handle> traps;
+    std::vector<tile_handle> fields;
+    std::unordered_map<vpart_id, tile_handle> vparts;
+    std::unordered_map<mtype_id, tile_handle> monsters;
+    std::unordered_map<itype_id, tile_handle> items;
+    std::unordered_map<mtype_id, tile_handle> corpses;
+    /** Season the handles were resolved for */
+    std::optional<season_type> season;
+
+    void clear();
+};
+
 class cata_tiles
 {
     public:
@@ -449,6 +494,25 @@ class cata_tiles
                                   const std::string &subcategory, const tripoint &pos, int subtile, int rota,
                                   lit_level ll, bool apply_night_vision_goggles, int &height_3d, int overlay_count,
                                   bool as_independent_entity = false );
+        /**
+         * @brief draw_from_id_string() for a game object, using its tile handle to skip the lookups.
+         *
+         * @param handle Tile handle of the object, resolved here on first use.
+         * @param id String id of the tile to draw, only used to resolve the handle.
+         * Other parameters are the same as for draw_from_id_string().
+         */
+        bool draw_from_tile_handle( tile_handle &handle, const std::string &id, TILE_CATEGORY category,
+                                    const std::string &subcategory, const tripoint &pos, int subtile, int rota,
+                                    lit_level ll, bool apply_night_vision_goggles, int &height_3d, int overlay_count );
+        /** Fills in @p handle with the results of tile_type_search() for the object. */
+        void resolve_tile_handle( tile_handle &handle, const std::string &id, TILE_CATEGORY category,
+                                  const std::string &subcategory, int subtile, int rota );
+        /**
+         * @brief Draws a tile found by tile_type_search(), the second half of draw_from_id_string().
+         */
+        bool draw_resolved_tile( const resolved_tile &tile, TILE_CATEGORY category, const tripoint &pos,
+                                 int rota, lit_level ll, bool apply_night_vision_goggles, int &height_3d,
+                                 int overlay_count, bool as_independent_entity );
         /**
         * @brief Draw overmap tile, if it's transparent, then draw lower tile first
         *
@@ -534,10 +598,10 @@ class cata_tiles
         bool has_furniture_memory_at( const tripoint &p ) const;
         bool has_trap_memory_at( const tripoint &p ) const;
         bool has_vpart_memory_at( const tripoint &p ) const;
-        memorized_terrain_tile get_terrain_memory_at( const tripoint &p ) const;
-        memorized_terrain_tile get_furniture_memory_at( const tripoint &p ) const;
-        memorized_terrain_tile get_trap_memory_at( const tripoint &p ) const;
-        memorized_terrain_tile get_vpart_memory_at( const tripoint &p ) const;
+        mm_packed_tile get_terrain_memory_at( const tripoint &p ) const;
+        mm_packed_tile get_furniture_memory_at( const tripoint &p ) const;
+        mm_packed_tile get_trap_memory_at( const tripoint &p ) const;
+        mm_packed_tile get_vpart_memory_at( const tripoint &p ) const;
 
         /** Drawing Layers */
         bool would_apply_vision_effects( visibility_type visibility ) const;
@@ -727,6 +791,8 @@ class cata_tiles
         std::unique_ptr<tileset> tileset_ptr;
         /** List of mods with which @ref tileset_ptr was loaded. */
         std::vector<mod_id> tileset_mod_list_stamp;
+        /** Tiles of game objects resolved for @ref tileset_ptr. */
+        tile_handle_cache tile_handles;
 
         int tile_height = 0;
         int tile_width = 0;
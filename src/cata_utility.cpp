@@ -569,7 +569,9 @@ bool read_from_file( const std::string &path, file_read_fn reader, bool optional
 bool read_from_file_json( const std::string &path, file_read_json_fn reader, bool optional )
 {
     return read_from_file( path, [&]( std::istream & fin ) {
-        JsonIn jsin( fin, path );
+        const std::string data( ( std::istreambuf_iterator<char>( fin ) ),
+                                std::istreambuf_iterator<char>() );
+        JsonIn jsin( data, path );
         reader( jsin );
     }, optional );
 }
@@ -668,8 +670,7 @@ std::string serialize_wrapper( const std::function<void( JsonOut & )> &callback
 
 void deserialize_wrapper( const std::function<void( JsonIn & )> &callback, const std::string &data )
 {
-    std::istringstream buffer( data );
-    JsonIn jsin( buffer );
+    JsonIn jsin( data );
     callback( jsin );
 }
 
@@ -1,13 +1,55 @@
 #include "compress.h"
 
 #include <zlib.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <queue>
 #include <vector>
 #include <string>
 #include <stdexcept>
 #include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
-void zlib_compress( const std::string &input, std::vector<std::byte> &output )
+static void zlib_compress_with_dictionary( const std::string &input, std::vector<std::byte> &output,
+        const std::string &dictionary )
 {
+    z_stream strm{};
+    if( deflateInit( &strm, Z_BEST_SPEED ) != Z_OK ) {
+        throw std::runtime_error( "Zlib compression error" );
+    }
+    if( deflateSetDictionary( &strm, reinterpret_cast<const Bytef *>( dictionary.data() ),
+                              dictionary.size() ) != Z_OK ) {
+        deflateEnd( &strm );
+        throw std::runtime_error( "Zlib compression error" );
+    }
+
+    output.resize( deflateBound( &strm, input.size() ) );
+    strm.next_in = reinterpret_cast<Bytef *>( const_cast<char *>( input.data() ) );
+    strm.avail_in = input.size();
+    strm.next_out = reinterpret_cast<Bytef *>( output.data() );
+    strm.avail_out = output.size();
+
+    const int result = deflate( &strm, Z_FINISH );
+    const size_t compressedSize = strm.total_out;
+    deflateEnd( &strm );
+    if( result != Z_STREAM_END ) {
+        throw std::runtime_error( "Zlib compression error" );
+    }
+
+    output.resize( compressedSize );
+}
+
+void zlib_compress( const std::string &input, std::vector<std::byte> &output,
+                    const std::string &dictionary )
+{
+    if( !dictionary.empty() ) {
+        zlib_compress_with_dictionary( input, output, dictionary );
+        return;
+    }
+
     uLongf compressedSize = compressBound( input.size() );
     output.resize( compressedSize );
 
@@ -26,8 +68,54 @@ void zlib_compress( const std::string &input, std::vector<std::byte> &output )
     output.resize( compressedSize );
 }
 
-void zlib_decompress( const void *compressed_data, int compressed_size, std::string &output )
+static void zlib_decompress_with_dictionary( const void *compressed_data, int compressed_size,
+        std::string &output, const std::string &dictionary )
 {
+    z_stream strm{};
+    if( inflateInit( &strm ) != Z_OK ) {
+        throw std::runtime_error( "Zlib decompression failed" );
+    }
+    strm.next_in = reinterpret_cast<Bytef *>( const_cast<void *>( compressed_data ) );
+    strm.avail_in = compressed_size;
+
+    // We need to guess at the decompressed size - we expect things to compress fairly well.
+    output.resize( static_cast<size_t>( compressed_size ) * 8 );
+    int result;
+    do {
+        strm.next_out = reinterpret_cast<Bytef *>( output.data() + strm.total_out );
+        strm.avail_out = output.size() - strm.total_out;
+        result = inflate( &strm, Z_NO_FLUSH );
+        if( result == Z_NEED_DICT ) {
+            result = inflateSetDictionary( &strm, reinterpret_cast<const Bytef *>( dictionary.data() ),
+                                           dictionary.size() );
+        }
+        if( result == Z_OK || result == Z_BUF_ERROR ) {
+            if( strm.avail_out == 0 ) {
+                output.resize( output.size() * 2 ); // Double the buffer size and retry
+            } else if( result == Z_BUF_ERROR ) {
+                // No progress possible with room left in the buffer: the input is truncated.
+                break;
+            }
+        }
+    } while( result == Z_OK || result == Z_BUF_ERROR );
+
+    const size_t decompressedSize = strm.total_out;
+    inflateEnd( &strm );
+    if( result != Z_STREAM_END ) {
+        throw std::runtime_error( "Zlib decompression failed" );
+    }
+
+    output.resize( decompressedSize );
+}
+
+void zlib_decompress( const void *compressed_data, int compressed_size, std::string &output,
+                      const std::string &dictionary )
+{
+    if( !dictionary.empty() ) {
+        zlib_decompress_with_dictionary( compressed_data, compressed_size, output, dictionary );
+        return;
+    }
+
     // We need to guess at the decompressed size - we expect things to compress fairly well.
     uLongf decompressedSize = static_cast<uLongf>( compressed_size ) * 8;
     output.resize( decompressedSize );
@@ -50,4 +138,95 @@ void zlib_decompress( const void *compressed_data, int compressed_size, std::str
     } while( result == Z_BUF_ERROR );
 
     output.resize( decompressedSize );
-}
\ No newline at end of file
+}
+
+// The trainer is a simplified version of the "cover" algorithm used by zstd: the
+// samples are cut into fixed-size segments, each segment is scored by how many
+// samples contain the short substrings (d-mers) it is made of, and the best segments
+// are picked greedily. Once a d-mer is covered by a picked segment, it stops counting
+// towards the score of the others, so the dictionary doesn't fill up with repeats.
+static constexpr size_t dmer_size = 8;
+static constexpr size_t segment_size = 64;
+static constexpr size_t segment_stride = 16;
+
+static uint64_t read_dmer( const std::string &s, size_t pos )
+{
+    uint64_t dmer = 0;
+    std::memcpy( &dmer, s.data() + pos, dmer_size );
+    return dmer;
+}
+
+std::string train_zlib_dictionary( const std::vector<std::string> &samples, size_t max_size )
+{
+    // How many samples contain each d-mer. A d-mer that only shows up in a single
+    // sample is of no use to the others.
+    std::unordered_map<uint64_t, int> dmer_freq;
+    for( const std::string &sample : samples ) {
+        if( sample.size() < dmer_size ) {
+            continue;
+        }
+        std::unordered_set<uint64_t> seen;
+        for( size_t pos = 0; pos + dmer_size <= sample.size(); pos++ ) {
+            seen.insert( read_dmer( sample, pos ) );
+        }
+        for( const uint64_t dmer : seen ) {
+            dmer_freq[dmer]++;
+        }
+    }
+
+    const auto score_segment = [&]( const std::string & sample, size_t start ) {
+        int64_t score = 0;
+        std::unordered_set<uint64_t> counted;
+        for( size_t pos = start; pos + dmer_size <= start + segment_size; pos++ ) {
+            const uint64_t dmer = read_dmer( sample, pos );
+            if( counted.insert( dmer ).second ) {
+                const int freq = dmer_freq[dmer];
+                score += freq > 1 ? freq : 0;
+            }
+        }
+        return score;
+    };
+
+    // ( score, ( sample, offset ) )
+    using candidate = std::pair<int64_t, std::pair<size_t, size_t>>;
+    std::priority_queue<candidate> candidates;
+    for( size_t i = 0; i < samples.size(); i++ ) {
+        for( size_t start = 0; start + segment_size <= samples[i].size(); start += segment_stride ) {
+            const int64_t score = score_segment( samples[i], start );
+            if( score > 0 ) {
+                candidates.emplace( score, std::make_pair( i, start ) );
+            }
+        }
+    }
+
+    std::vector<std::pair<size_t, size_t>> picked;
+    size_t dict_size = 0;
+    while( !candidates.empty() && dict_size + segment_size <= max_size ) {
+        const candidate top = candidates.top();
+        candidates.pop();
+        const std::string &sample = samples[top.second.first];
+        // Scores only ever decrease as d-mers get covered, so a stale score is an upper bound.
+        // Re-queue the segment if it no longer beats the next best one.
+        const int64_t score = score_segment( sample, top.second.second );
+        if( score <= 0 ) {
+            continue;
+        }
+        if( !candidates.empty() && score < candidates.top().first ) {
+            candidates.emplace( score, top.second );
+            continue;
+        }
+        picked.push_back( top.second );
+        dict_size += segment_size;
+        for( size_t pos = top.second.second; pos + dmer_size <= top.second.second + segment_size; pos++ ) {
+            dmer_freq[read_dmer( sample, pos )] = 0;
+        }
+    }
+
+    // Deflate encodes short distances more cheaply, so the most useful content goes last.
+    std::string dictionary;
+    dictionary.reserve( dict_size );
+    for( auto it = picked.rbegin(); it != picked.rend(); ++it ) {
+        dictionary.append( samples[it->first], it->second, segment_size );
+    }
+    return dictionary;
+}
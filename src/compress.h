@@ -1,10 +1,28 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 #include "fstream_utils.h"
 
-void zlib_compress( const std::string &input, std::vector<std::byte> &output );
-void zlib_decompress( const void *compressed_data, int compressed_size, std::string &output );
+/**
+ * Compress @p input in the zlib format. If @p dictionary is not empty, it is used
+ * as a preset dictionary, and the same dictionary must be passed to decompress.
+ * Small blobs compressed against a dictionary also decompress faster, since
+ * there is much less compressed input for inflate to decode.
+ */
+void zlib_compress( const std::string &input, std::vector<std::byte> &output,
+                    const std::string &dictionary = std::string() );
+void zlib_decompress( const void *compressed_data, int compressed_size, std::string &output,
+                      const std::string &dictionary = std::string() );
 
+/**
+ * Build a preset dictionary of at most @p max_size bytes out of the substrings
+ * that recur across the most @p samples. Small inputs that share a lot of structure
+ * (like the JSON of individual map quads) compress much better against it.
+ *
+ * Returns an empty string if the samples don't share enough content to be worth it.
+ */
+std::string train_zlib_dictionary( const std::vector<std::string> &samples, size_t max_size );
 
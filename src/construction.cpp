@@ -197,11 +197,18 @@ void reset()
 
 void check_consistency()
 {
-    // Legacy migration from when single string was used for both terrain
-    // and furniture id.
-    // TODO: remove this after reaching BN equivalent of 0.F (or 0.G)
+    all_constructions.check();
+}
+
+void finalize()
+{
+    all_constructions.finalize();
+
     for( const construction &c_it : all_constructions.get_all() ) {
         construction &c = const_cast<construction &>( c_it );
+        // Legacy migration from when single string was used for both terrain
+        // and furniture id.
+        // TODO: remove this after reaching BN equivalent of 0.F (or 0.G)
         bool did_migrate = false;
         if( c.pre_terrain.str().starts_with( "f_" ) ) {
             c.pre_furniture = furn_str_id( c.pre_terrain.str() );
@@ -217,17 +224,6 @@ void check_consistency()
             debugmsg( "Construction '%s' uses pre_/post_terrain to set furniture id.  Use pre_/post_furniture instead.",
                       c.id );
         }
-    }
-
-    all_constructions.check();
-}
-
-void finalize()
-{
-    all_constructions.finalize();
-
-    for( const construction &c_it : all_constructions.get_all() ) {
-        construction &c = const_cast<construction &>( c_it );
         c.finalize();
         inp_mngr.pump_events();
     }
@@ -7,6 +7,8 @@
 #include <utility>
 
 #include "debug.h"
+#include "game_constants.h"
+#include "line.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "mtype.h"
@@ -16,7 +18,26 @@
 
 #define dbg(x) DebugLogFL((x),DC::Game)
 
-Creature_tracker::Creature_tracker() = default;
+static constexpr int num_submap_buckets = MAPSIZE * MAPSIZE * OVERMAP_LAYERS;
+
+static bool in_bucket_range( const tripoint &p )
+{
+    return p.x >= 0 && p.y >= 0 && p.x < MAPSIZE_X && p.y < MAPSIZE_Y &&
+           p.z >= -OVERMAP_DEPTH && p.z <= OVERMAP_HEIGHT;
+}
+
+static int bucket_index( const tripoint &p )
+{
+    if( !in_bucket_range( p ) ) {
+        return num_submap_buckets;
+    }
+    return ( ( p.z + OVERMAP_DEPTH ) * MAPSIZE + p.y / SEEY ) * MAPSIZE + p.x / SEEX;
+}
+
+Creature_tracker::Creature_tracker() : monsters_by_submap( num_submap_buckets + 1 ),
+    monsters_on_level( OVERMAP_LAYERS, 0 )
+{
+}
 
 Creature_tracker::~Creature_tracker() = default;
 
@@ -32,6 +53,42 @@ shared_ptr_fast<monster> Creature_tracker::find( const tripoint &pos ) const
     return nullptr;
 }
 
+std::vector<monster *> Creature_tracker::monsters_in_radius( const tripoint &center,
+        const int radius, const std::function<bool( const monster & )> &filter ) const
+{
+    std::vector<monster *> result;
+    const auto consider = [&]( monster * critter ) {
+        if( !critter->is_dead() && rl_dist( center, critter->pos() ) <= radius &&
+            ( !filter || filter( *critter ) ) ) {
+            result.push_back( critter );
+        }
+    };
+
+    const int min_z = std::max( center.z - radius, -OVERMAP_DEPTH );
+    const int max_z = std::min( center.z + radius, OVERMAP_HEIGHT );
+    const int min_smx = std::max( center.x - radius, 0 ) / SEEX;
+    const int min_smy = std::max( center.y - radius, 0 ) / SEEY;
+    const int max_smx = std::min( center.x + radius, MAPSIZE_X - 1 ) / SEEX;
+    const int max_smy = std::min( center.y + radius, MAPSIZE_Y - 1 ) / SEEY;
+    for( int z = min_z; z <= max_z; ++z ) {
+        if( monsters_on_level[z + OVERMAP_DEPTH] == 0 ) {
+            continue;
+        }
+        for( int smy = min_smy; smy <= max_smy; ++smy ) {
+            for( int smx = min_smx; smx <= max_smx; ++smx ) {
+                const int index = ( ( z + OVERMAP_DEPTH ) * MAPSIZE + smy ) * MAPSIZE + smx;
+                for( monster *critter : monsters_by_submap[index] ) {
+                    consider( critter );
+                }
+            }
+        }
+    }
+    for( monster *critter : monsters_by_submap[num_submap_buckets] ) {
+        consider( critter );
+    }
+    return result;
+}
+
 int Creature_tracker::temporary_id( const monster &critter ) const
 {
     const auto iter = std::ranges::find_if( monsters_list,
@@ -86,7 +143,7 @@ bool Creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
     }
 
     monsters_list.emplace_back( critter_ptr );
-    monsters_by_location[critter.pos()] = critter_ptr;
+    set_location( critter.pos(), critter_ptr );
     add_to_faction_map( critter_ptr );
     return true;
 }
@@ -164,8 +221,11 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
         return ptr.get() == &critter;
     } );
     if( iter != monsters_list.end() ) {
-        monsters_by_location.erase( critter.pos() );
-        monsters_by_location[new_pos] = *iter;
+        const auto old_iter = monsters_by_location.find( critter.pos() );
+        if( old_iter != monsters_by_location.end() ) {
+            erase_location( old_iter );
+        }
+        set_location( new_pos, *iter );
         return true;
     } else {
         const tripoint &old_pos = critter.pos();
@@ -184,7 +244,7 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
 {
     const auto pos_iter = monsters_by_location.find( critter.pos() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
-        monsters_by_location.erase( pos_iter );
+        erase_location( pos_iter );
         return;
     }
 
@@ -195,7 +255,56 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
         return v.second.get() == &critter;
     } );
     if( iter != monsters_by_location.end() ) {
-        monsters_by_location.erase( iter );
+        erase_location( iter );
+    }
+}
+
+void Creature_tracker::set_location( const tripoint &pos,
+                                     const shared_ptr_fast<monster> &critter )
+{
+    shared_ptr_fast<monster> &entry = monsters_by_location[pos];
+    if( entry ) {
+        remove_from_bucket( pos, entry.get() );
+    }
+    entry = critter;
+    add_to_bucket( pos, critter.get() );
+}
+
+void Creature_tracker::erase_location( decltype( monsters_by_location )::iterator iter )
+{
+    remove_from_bucket( iter->first, iter->second.get() );
+    monsters_by_location.erase( iter );
+}
+
+void Creature_tracker::clear_locations()
+{
+    monsters_by_location.clear();
+    for( std::vector<monster *> &bucket : monsters_by_submap ) {
+        bucket.clear();
+    }
+    std::ranges::fill( monsters_on_level, 0 );
+}
+
+void Creature_tracker::add_to_bucket( const tripoint &pos, monster *critter )
+{
+    monsters_by_submap[bucket_index( pos )].push_back( critter );
+    if( in_bucket_range( pos ) ) {
+        monsters_on_level[pos.z + OVERMAP_DEPTH]++;
+    }
+}
+
+void Creature_tracker::remove_from_bucket( const tripoint &pos, const monster *critter )
+{
+    std::vector<monster *> &bucket = monsters_by_submap[bucket_index( pos )];
+    const auto iter = std::ranges::find( bucket, critter );
+    if( iter == bucket.end() ) {
+        return;
+    }
+    // Order within a bucket doesn't matter
+    *iter = bucket.back();
+    bucket.pop_back();
+    if( in_bucket_range( pos ) ) {
+        monsters_on_level[pos.z + OVERMAP_DEPTH]--;
     }
 }
 
@@ -227,17 +336,17 @@ void Creature_tracker::remove( const monster &critter )
 void Creature_tracker::clear()
 {
     monsters_list.clear();
-    monsters_by_location.clear();
+    clear_locations();
     monster_faction_map_.clear();
     removed_.clear();
 }
 
 void Creature_tracker::rebuild_cache()
 {
-    monsters_by_location.clear();
+    clear_locations();
     monster_faction_map_.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
-        monsters_by_location[mon_ptr->pos()] = mon_ptr;
+        set_location( mon_ptr->pos(), mon_ptr );
         add_to_faction_map( mon_ptr );
     }
 }
@@ -256,13 +365,13 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     shared_ptr_fast<monster> first_ptr;
     if( first_iter != monsters_by_location.end() ) {
         first_ptr = first_iter->second;
-        monsters_by_location.erase( first_iter );
+        erase_location( first_iter );
     }
 
     shared_ptr_fast<monster> second_ptr;
     if( second_iter != monsters_by_location.end() ) {
         second_ptr = second_iter->second;
-        monsters_by_location.erase( second_iter );
+        erase_location( second_iter );
     }
     // implied: (first_ptr != second_ptr) or (first_ptr == nullptr && second_ptr == nullptr)
 
@@ -272,10 +381,10 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
 
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
-        monsters_by_location[first.pos()] = first_ptr;
+        set_location( first.pos(), first_ptr );
     }
     if( second_ptr ) {
-        monsters_by_location[second.pos()] = second_ptr;
+        set_location( second.pos(), second_ptr );
     }
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <set>
 #include <unordered_map>
@@ -47,6 +48,14 @@ class Creature_tracker
          * Dead monsters are ignored and not returned.
          */
         shared_ptr_fast<monster> find( const tripoint &pos ) const;
+        /**
+         * Returns the monsters within @p radius (as measured by @ref rl_dist) of @p center
+         * for which @p filter returns true, or all of them if no filter is given.
+         * Dead monsters are ignored. The order of the result is unspecified.
+         * Only the monsters on the map squares near @p center are looked at.
+         */
+        std::vector<monster *> monsters_in_radius( const tripoint &center, int radius,
+                const std::function<bool( const monster & )> &filter = nullptr ) const;
         /**
          * Returns a temporary id of the given monster (which must exist in the tracker).
          * The id is valid until monsters are added or removed from the tracker.
@@ -94,8 +103,22 @@ class Creature_tracker
     private:
         std::vector<shared_ptr_fast<monster>> monsters_list;
         std::unordered_map<tripoint, shared_ptr_fast<monster>> monsters_by_location;
+        /**
+         * The monsters of @ref monsters_by_location, bucketed by the submap of the reality
+         * bubble they are on. The last bucket holds monsters outside of the bubble.
+         */
+        std::vector<std::vector<monster *>> monsters_by_submap;
+        /** Number of monsters in @ref monsters_by_submap on each z-level */
+        std::vector<int> monsters_on_level;
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
+        /** Sets the entry of @ref monsters_by_location at @p pos, keeping the buckets in sync */
+        void set_location( const tripoint &pos, const shared_ptr_fast<monster> &critter );
+        /** Erases an entry of @ref monsters_by_location, keeping the buckets in sync */
+        void erase_location( decltype( monsters_by_location )::iterator iter );
+        void clear_locations();
+        void add_to_bucket( const tripoint &pos, monster *critter );
+        void remove_from_bucket( const tripoint &pos, const monster *critter );
 };
 
 
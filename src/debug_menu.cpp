@@ -59,6 +59,7 @@
 #include "map.h"
 #include "map_extras.h"
 #include "map_iterator.h"
+#include "map_memory.h"
 #include "mapgen.h"
 #include "mapgendata.h"
 #include "martialarts.h"
@@ -1518,6 +1519,10 @@ void debug()
             if( get_option<bool>( "STATS_THROUGH_KILLS" ) ) {
                 add_msg( m_info, _( "Kill xp: %d" ), u.kill_xp() );
             }
+            const map_memory &memory = u.get_map_memory();
+            add_msg( m_info, _( "Map memory: %d submaps, %d tile ids, %d KiB" ),
+                     memory.loaded_submaps(), memorized_tile_ids::size(),
+                     ( memory.memory_usage() + memorized_tile_ids::memory_usage() ) / 1024 );
             g->invalidate_main_ui_adaptor();
             g->disp_NPCs();
             break;
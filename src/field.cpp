@@ -155,9 +155,10 @@ field_entry *field::find_field( const field_type_id &field_type_to_find )
     if( !_displayed_field_type ) {
         return nullptr;
     }
-    const auto it = _field_type_list.find( field_type_to_find );
-    if( it != _field_type_list.end() ) {
-        return &it->second;
+    for( auto &fld : _field_type_list ) {
+        if( fld.first == field_type_to_find ) {
+            return &fld.second;
+        }
     }
     return nullptr;
 }
@@ -167,9 +168,10 @@ const field_entry *field::find_field_c( const field_type_id &field_type_to_find
     if( !_displayed_field_type ) {
         return nullptr;
     }
-    const auto it = _field_type_list.find( field_type_to_find );
-    if( it != _field_type_list.end() ) {
-        return &it->second;
+    for( auto &fld : _field_type_list ) {
+        if( fld.first == field_type_to_find ) {
+            return &fld.second;
+        }
     }
     return nullptr;
 }
@@ -195,7 +197,8 @@ bool field::add_field( const field_type_id &field_type_to_add, const int new_int
         debugmsg( "Tried to add null field" );
         return false;
     }
-    auto it = _field_type_list.find( field_type_to_add );
+    const auto it = std::ranges::find( _field_type_list, field_type_to_add,
+                                       &entry_list::value_type::first );
     if( it != _field_type_list.end() ) {
         // Most fields stack intensities, but some add duration instead
         if( it->first->stacking_type == fields::stacking_type::intensity ) {
@@ -212,13 +215,15 @@ bool field::add_field( const field_type_id &field_type_to_add, const int new_int
         field_type_to_add.obj().priority >= _displayed_field_type.obj().priority ) {
         _displayed_field_type = field_type_to_add;
     }
-    _field_type_list[field_type_to_add] = field_entry( field_type_to_add, new_intensity, new_age );
+    _field_type_list.emplace_back( field_type_to_add,
+                                   field_entry( field_type_to_add, new_intensity, new_age ) );
     return true;
 }
 
 bool field::remove_field( const field_type_id &field_to_remove )
 {
-    const auto it = _field_type_list.find( field_to_remove );
+    const auto it = std::ranges::find( _field_type_list, field_to_remove,
+                                       &entry_list::value_type::first );
     if( it == _field_type_list.end() ) {
         return false;
     }
@@ -226,8 +231,9 @@ bool field::remove_field( const field_type_id &field_to_remove )
     return true;
 }
 
-void field::remove_field( std::map<field_type_id, field_entry>::iterator const it )
+field::entry_list::iterator field::remove_field( entry_list::iterator const it )
 {
+    const size_t index = it - _field_type_list.begin();
     _field_type_list.erase( it );
     _displayed_field_type = fd_null;
     if( !_field_type_list.empty() ) {
@@ -237,6 +243,7 @@ void field::remove_field( std::map<field_type_id, field_entry>::iterator const i
             }
         }
     }
+    return _field_type_list.begin() + index;
 }
 
 /*
@@ -248,22 +255,22 @@ unsigned int field::field_count() const
     return _field_type_list.size();
 }
 
-std::map<field_type_id, field_entry>::iterator field::begin()
+field::entry_list::iterator field::begin()
 {
     return _field_type_list.begin();
 }
 
-std::map<field_type_id, field_entry>::const_iterator field::begin() const
+field::entry_list::const_iterator field::begin() const
 {
     return _field_type_list.begin();
 }
 
-std::map<field_type_id, field_entry>::iterator field::end()
+field::entry_list::iterator field::end()
 {
     return _field_type_list.end();
 }
 
-std::map<field_type_id, field_entry>::const_iterator field::end() const
+field::entry_list::const_iterator field::end() const
 {
     return _field_type_list.end();
 }
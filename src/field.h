@@ -1,7 +1,7 @@
 #pragma once
 
-#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "calendar.h"
@@ -128,6 +128,10 @@ class field_entry
 class field
 {
     public:
+        // Only a handful of fields ever share a tile, so a flat vector searched linearly beats a
+        // node based map both in lookup speed and in the memory every tile of every submap needs.
+        using entry_list = std::vector<std::pair<field_type_id, field_entry>>;
+
         field();
 
         /**
@@ -166,8 +170,9 @@ class field
         /**
          * Make sure to decrement the field counter in the submap.
          * Removes the field entry, the iterator must point into @ref _field_type_list and must be valid.
+         * @return Iterator to the entry after the removed one.
          */
-        void remove_field( std::map<field_type_id, field_entry>::iterator );
+        entry_list::iterator remove_field( entry_list::iterator );
 
         // Returns the number of fields existing on the current tile.
         unsigned int field_count() const;
@@ -180,12 +185,12 @@ class field
         description_affix displayed_description_affix() const;
 
         //Returns the vector iterator to begin searching through the list.
-        std::map<field_type_id, field_entry>::iterator begin();
-        std::map<field_type_id, field_entry>::const_iterator begin() const;
+        entry_list::iterator begin();
+        entry_list::const_iterator begin() const;
 
         //Returns the vector iterator to end searching through the list.
-        std::map<field_type_id, field_entry>::iterator end();
-        std::map<field_type_id, field_entry>::const_iterator end() const;
+        entry_list::iterator end();
+        entry_list::const_iterator end() const;
 
         /**
          * Returns the total move cost from all fields.
@@ -193,8 +198,9 @@ class field
         int total_move_cost() const;
 
     private:
-        // A pointer lookup table of all field effects on the current tile.
-        std::map<field_type_id, field_entry> _field_type_list;
+        // All field effects on the current tile, in the order they were added.
+        // Adding an entry may move the others, removing one keeps the order of the rest.
+        entry_list _field_type_list;
         //_displayed_field_type currently is equal to the last field added to the square. You can modify this behavior in the class functions if you wish.
         field_type_id _displayed_field_type;
 };
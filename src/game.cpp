@@ -1606,8 +1606,8 @@ bool game::do_turn()
     // reset player noise
     u.volume = 0;
 
-    // Finally, clear pathfinding cache
-    Pathfinding::clear_d_maps();
+    // Finally, drop pathfinding cache that won't hold next turn
+    Pathfinding::end_turn();
 
     return false;
 }
@@ -2760,6 +2760,10 @@ bool game::save( bool quitting )
     }
 
     world->start_save_tx();
+    // A save that doesn't make it to the commit must not leave half of itself behind.
+    on_out_of_scope rollback( [world]() {
+        world->rollback_save_tx();
+    } );
 
     cata::run_on_game_save_hooks( *DynamicDataLoader::get_instance().lua );
     try {
@@ -2781,6 +2785,7 @@ bool game::save( bool quitting )
             world_generator->save_last_world_info();
             world_generator->active_world->info->add_save( save_t::from_save_id( u.get_save_id() ) );
 
+            rollback.cancel();
             auto duration = world->commit_save_tx();
             add_msg( m_info, _( "World Saved (took %dms)." ), duration );
             return true;
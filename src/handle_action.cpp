@@ -734,18 +734,20 @@ static void smash()
             crit->use_mech_power( -3 );
         }
     }
-    for( std::pair<const field_type_id, field_entry> &fd_to_smsh : here.field_at( smashp ) ) {
-        const map_bash_info &bash_info = fd_to_smsh.first->bash_info;
+    for( const std::pair<field_type_id, field_entry> &fd_to_smsh : here.field_at( smashp ) ) {
+        // Copied, as removing the field below overwrites the entry
+        const field_type_id fd_type = fd_to_smsh.first;
+        const map_bash_info &bash_info = fd_type->bash_info;
         if( bash_info.str_min == -1 ) {
             continue;
         }
         if( smashskill < bash_info.str_min ) {
-            add_msg( m_neutral, _( "You don't seem to be damaging the %s." ), fd_to_smsh.first->get_name() );
+            add_msg( m_neutral, _( "You don't seem to be damaging the %s." ), fd_type->get_name() );
             return;
         } else if( smashskill >= rng( bash_info.str_min, bash_info.str_max ) ) {
             sounds::sound( smashp, bash_info.sound_vol.value_or( -1 ),
                            sounds::sound_t::combat, bash_info.sound, true, "smash", "field" );
-            here.remove_field( smashp, fd_to_smsh.first );
+            here.remove_field( smashp, fd_type );
             here.spawn_items( smashp, item_group::items_from( bash_info.drop_group, calendar::turn ) );
             u.mod_moves( - bash_info.fd_bash_move_cost );
             add_msg( m_info, bash_info.field_bash_msg_success.translated() );
@@ -1,14 +1,19 @@
 #include "init.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <deque>
 #include <exception>
+#include <filesystem>
 #include <fstream>
+#include <future>
 #include <iterator>
 #include <memory>
 #include <sstream> // for throwing errors
 #include <stdexcept>
 #include <string>
+#include <system_error>
 #include <vector>
 
 #include "achievement.h"
@@ -21,6 +26,7 @@
 #include "behavior.h"
 #include "bionics.h"
 #include "bodypart.h"
+#include "cached_options.h"
 #include "catalua.h"
 #include "cata_utility.h"
 #include "clothing_mod.h"
@@ -46,7 +52,9 @@
 #include "flag.h"
 #include "flag_trait.h"
 #include "gates.h"
+#include "get_version.h"
 #include "harvest.h"
+#include "hash_utils.h"
 #include "item_action.h"
 #include "item_category.h"
 #include "item_factory.h"
@@ -80,6 +88,7 @@
 #include "overmap_connection.h"
 #include "overmap_location.h"
 #include "overmap_special.h"
+#include "path_info.h"
 #include "profession.h"
 #include "recipe_dictionary.h"
 #include "recipe_groups.h"
@@ -96,6 +105,7 @@
 #include "start_location.h"
 #include "string_formatter.h"
 #include "text_snippets.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "trap.h"
 #include "type_id.h"
@@ -486,21 +496,24 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back( path );
         }
     }
+    // The files are read into ram on the thread pool, a few ahead of the one being loaded.
+    // Loading itself stays serial and in order, as objects may refer to earlier ones.
+    constexpr size_t read_ahead = 32;
+    std::deque<std::future<std::string>> contents;
+    size_t next_read = 0;
     // iterate over each file
     for( auto &files_i : files ) {
         const std::string &file = files_i;
-        // open the file as a stream
-        cata_ifstream infile = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( file ) );
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                ( std::istreambuf_iterator<char>( *infile ) ),
-                std::istreambuf_iterator<char>()
-            )
-        );
+        for( ; next_read < files.size() && contents.size() < read_ahead; next_read++ ) {
+            contents.push_back( get_thread_pool().submit( [to_read = files[next_read]]() {
+                return read_entire_file( to_read );
+            } ) );
+        }
+        const std::string data = contents.front().get();
+        contents.pop_front();
         try {
             // parse it
-            JsonIn jsin( iss, file );
+            JsonIn jsin( data, file );
             load_all_from_json( jsin, src, ui, path, file );
         } catch( const JsonError &err ) {
             throw std::runtime_error( err.what() );
@@ -709,6 +722,7 @@ void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
             { _( "Harvest lists" ), &harvest_list::finalize_all },
             { _( "Anatomies" ), &anatomy::finalize_all },
             { _( "Mutations" ), &mutation_branch::finalize },
+            { _( "Scenario blacklist" ), &finalize_scenarios_blacklist },
             { _( "Achievements" ), &achievement::finalize },
             { _( "Localization" ), &l10n_data::load_mod_catalogues },
 #if defined(TILES)
@@ -825,14 +839,85 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
     finalized = true;
 }
 
+void DynamicDataLoader::skip_consistency_checks()
+{
+    finalized = true;
+}
+
+size_t init::files_fingerprint( const std::string &path )
+{
+    size_t fingerprint = 0;
+    for( const std::string &file : get_files_from_path( "", path, true ) ) {
+        const std::filesystem::path file_path( file );
+        std::error_code ec;
+        cata::hash_combine( fingerprint, file );
+        cata::hash_combine( fingerprint, std::filesystem::file_size( file_path, ec ) );
+        cata::hash_combine( fingerprint,
+                            std::filesystem::last_write_time( file_path, ec ).time_since_epoch().count() );
+    }
+    return fingerprint;
+}
+
+size_t init::data_fingerprint( const std::vector<mod_id> &packs )
+{
+    size_t fingerprint = 0;
+    cata::hash_combine( fingerprint, std::string( getVersionString() ) );
+    for( const mod_id &mod : packs ) {
+        cata::hash_combine( fingerprint, mod.str() );
+        cata::hash_combine( fingerprint, files_fingerprint( mod->path ) );
+    }
+    return fingerprint;
+}
+
+static std::vector<size_t> read_verified_data()
+{
+    std::vector<size_t> verified;
+    read_from_file( PATH_INFO::verified_data(), [&verified]( std::istream & fin ) {
+        size_t fingerprint = 0;
+        while( fin >> fingerprint ) {
+            verified.push_back( fingerprint );
+        }
+        // Stopping at the end of the file is expected
+        fin.clear();
+    }, true );
+    return verified;
+}
+
+bool init::is_data_verified( size_t fingerprint )
+{
+    const std::vector<size_t> verified = read_verified_data();
+    return std::ranges::find( verified, fingerprint ) != verified.end();
+}
+
+void init::mark_data_verified( size_t fingerprint )
+{
+    // Remember a few mod lists, so switching between worlds doesn't check every time
+    constexpr size_t max_remembered = 16;
+    std::vector<size_t> verified = read_verified_data();
+    if( std::ranges::find( verified, fingerprint ) != verified.end() ) {
+        return;
+    }
+    verified.push_back( fingerprint );
+    if( verified.size() > max_remembered ) {
+        verified.erase( verified.begin(), verified.end() - max_remembered );
+    }
+    write_to_file( PATH_INFO::verified_data(), [&verified]( std::ostream & fout ) {
+        for( const size_t fp : verified ) {
+            fout << fp << '\n';
+        }
+    }, "" );
+}
+
 /**
  * Load & finalize specified content packs.
  * @param ui structure for load progress display
  * @param msg string to display whilst loading prompt
  * @param packs content packs to load in correct dependent order
+ * @param may_skip_checks whether the consistency checks may be skipped for data that
+ * already passed them, see @ref skip_verified_data_checks
  */
 static void load_and_finalize_packs( loading_ui &ui, const std::string &msg,
-                                     const std::vector<mod_id> &packs )
+                                     const std::vector<mod_id> &packs, bool may_skip_checks = true )
 {
     ui.new_context( msg );
     std::vector<mod_id> missing;
@@ -899,7 +984,19 @@ static void load_and_finalize_packs( loading_ui &ui, const std::string &msg,
         }
     }
 
-    loader.check_consistency( ui );
+    if( may_skip_checks && skip_verified_data_checks ) {
+        const size_t fingerprint = init::data_fingerprint( available );
+        if( init::is_data_verified( fingerprint ) ) {
+            loader.skip_consistency_checks();
+        } else {
+            loader.check_consistency( ui );
+            if( !debug_has_error_been_observed() ) {
+                init::mark_data_verified( fingerprint );
+            }
+        }
+    } else {
+        loader.check_consistency( ui );
+    }
 
     if( cata::has_lua() ) {
         init::load_main_lua_scripts( *loader.lua, packs );
@@ -1037,7 +1134,7 @@ bool init::check_mods_for_errors( loading_ui &ui, const std::vector<mod_id> &opt
         mods_list.push_back( id );
 
         try {
-            load_and_finalize_packs( ui, _( "Checking mods" ), mods_list );
+            load_and_finalize_packs( ui, _( "Checking mods" ), mods_list, false );
         } catch( const std::exception &err ) {
             std::cerr << "Error loading data: " << err.what() << '\n';
         }
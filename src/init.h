@@ -118,9 +118,16 @@ class DynamicDataLoader
         /**
          * Check the consistency of all the loaded data.
          * May print a debugmsg if something seems wrong.
+         * Must not change data that passes the checks, anything the game relies on belongs in
+         * @ref finalize_loaded_data, see @ref skip_consistency_checks.
          * @param ui Finalization status display.
          */
         void check_consistency( loading_ui &ui );
+        /**
+         * Marks the loaded data as ready without checking it, for data that is known to have
+         * passed @ref check_consistency before.
+         */
+        void skip_consistency_checks();
 
         /**
          * Returns the single instance of this class.
@@ -186,6 +193,28 @@ void load_main_lua_scripts( cata::lua_state &state, const std::vector<mod_id> &p
 /** Returns whether the game data is currently loaded. */
 bool is_data_loaded();
 
+/**
+ * Fingerprint of the files under @p path: the path, size and modification time of each.
+ * Editing, adding or removing a file changes it.
+ */
+size_t files_fingerprint( const std::string &path );
+
+/**
+ * Fingerprint of the game data loaded from @p packs: the game version, the pack ids and
+ * @ref files_fingerprint of every pack.
+ */
+size_t data_fingerprint( const std::vector<mod_id> &packs );
+
+/**
+ * Whether data with @p fingerprint already passed the consistency checks, see
+ * @ref skip_verified_data_checks. Only the checks are skipped for such data; it is still
+ * loaded and finalized from the JSON files as usual.
+ */
+bool is_data_verified( size_t fingerprint );
+
+/** Records that data with @p fingerprint passed the consistency checks. */
+void mark_data_verified( size_t fingerprint );
+
 /**
  * Load & finalize modlist that consists of single vanilla BN core "mod".
  * @throw std::exception if the loaded data is not valid.
@@ -9547,8 +9547,7 @@ detached_ptr<item>  item::process_rot( detached_ptr<item> &&self, const bool sea
     if( now - time > 1_hours ) {
         // This code is for items that were left out of reality bubble for long time
 
-        const weather_generator &wgen = weather.get_cur_weather_gen();
-        const unsigned int seed = g->get_seed();
+        const tripoint_abs_ms location( get_map().getabs( pos ) );
         // It's a modifier, so we need to subtract 0_f
         units::temperature local_mod = units::from_fahrenheit( g->new_game
                                        ? 0
@@ -9563,10 +9562,7 @@ detached_ptr<item>  item::process_rot( detached_ptr<item> &&self, const bool sea
             //Use weather if above ground, use map temp if below
             units::temperature env_temperature_raw;
             if( pos.z >= 0 ) {
-                tripoint_abs_ms location = tripoint_abs_ms( get_map().getabs( pos ) );
-                units::temperature weather_temperature = wgen.get_weather_temperature( location, time,
-                        calendar::config, seed );
-                env_temperature_raw = weather_temperature + local_mod;
+                env_temperature_raw = weather.get_weather_temperature( location, time ) + local_mod;
             } else {
                 env_temperature_raw = temperatures::annual_average + local_mod;
             }
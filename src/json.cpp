@@ -14,6 +14,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -87,25 +88,46 @@ JsonObject::JsonObject( JsonIn &j )
     while( !jsin->end_object() ) {
         std::string n = jsin->get_member_name();
         int p = jsin->tell();
-        if( positions.contains( n ) ) {
+        const auto iter = std::ranges::lower_bound( positions, n, {}, &member_position::name );
+        if( iter != positions.end() && iter->name == n ) {
             j.error( "duplicate entry in json object" );
         }
-        positions[n] = p;
+        positions.insert( iter, member_position{ std::move( n ), p } );
         jsin->skip_value();
     }
     end_ = jsin->tell();
     final_separator = jsin->get_ate_separator();
 }
 
+const JsonObject::member_position *JsonObject::find_member( const std::string &name ) const
+{
+    const auto iter = std::ranges::lower_bound( positions, name, {}, &member_position::name );
+    if( iter == positions.end() || iter->name != name ) {
+        return nullptr;
+    }
+    return &*iter;
+}
+
 void JsonObject::mark_visited( const std::string &name ) const
 {
 #ifndef CATA_IN_TOOL
-    visited_members.emplace( name );
+    if( const member_position *member = find_member( name ) ) {
+        mark_visited( *member );
+    }
 #else
     static_cast<void>( name );
 #endif
 }
 
+void JsonObject::mark_visited( const member_position &member ) const
+{
+#ifndef CATA_IN_TOOL
+    member.visited = true;
+#else
+    static_cast<void>( member );
+#endif
+}
+
 void JsonObject::report_unvisited() const
 {
 #ifndef CATA_IN_TOOL
@@ -116,9 +138,9 @@ void JsonObject::report_unvisited() const
         && !std::uncaught_exceptions()
     ) {
         reported_unvisited_members = true;
-        for( const std::pair<const std::string, int> &p : positions ) {
-            const std::string &name = p.first;
-            if( !visited_members.contains( name ) && !name.starts_with( "//" ) ) {
+        for( const member_position &member : positions ) {
+            const std::string &name = member.name;
+            if( !member.visited && !name.starts_with( "//" ) ) {
                 try {
                     throw_error( string_format( "Invalid or misplaced field name \"%s\" in JSON data", name ), name );
                 } catch( const JsonError &e ) {
@@ -166,8 +188,8 @@ int JsonObject::verify_position( const std::string &name,
         // so it will never indicate a valid member position
         return 0;
     }
-    const auto iter = positions.find( name );
-    if( iter == positions.end() ) {
+    const member_position *member = find_member( name );
+    if( member == nullptr ) {
         if( throw_exception ) {
             jsin->seek( start );
             jsin->error( "member not found: " + name );
@@ -176,12 +198,12 @@ int JsonObject::verify_position( const std::string &name,
         // so it will never indicate a valid member position
         return 0;
     }
-    return iter->second;
+    return member->position;
 }
 
 bool JsonObject::has_member( const std::string &name ) const
 {
-    return positions.contains( name );
+    return find_member( name ) != nullptr;
 }
 
 std::string JsonObject::line_number() const
@@ -809,6 +831,65 @@ void add_array_to_set( std::set<std::string> &s, const JsonObject &json, const s
     }
 }
 
+// Read-only stream buffer over memory. The stream based code reads through it as usual,
+// while the hot paths move through the data directly.
+class JsonIn::buffer_source : public std::streambuf
+{
+    public:
+        std::istream stream;
+
+        explicit buffer_source( std::string_view data ) : stream( this ) {
+            char *begin = const_cast<char *>( data.data() );
+            setg( begin, begin, begin + data.size() );
+        }
+
+        const char *cursor() const {
+            return gptr();
+        }
+        const char *end() const {
+            return egptr();
+        }
+        void advance_to( const char *p ) {
+            setg( eback(), const_cast<char *>( p ), egptr() );
+        }
+
+    protected:
+        pos_type seekoff( off_type off, std::ios_base::seekdir dir,
+                          std::ios_base::openmode which ) override {
+            const char *base = dir == std::ios_base::beg ? eback() :
+                               dir == std::ios_base::cur ? gptr() : egptr();
+            const off_type target = base - eback() + off;
+            if( !( which & std::ios_base::in ) || target < 0 || target > egptr() - eback() ) {
+                return pos_type( off_type( -1 ) );
+            }
+            setg( eback(), eback() + target, egptr() );
+            return pos_type( target );
+        }
+        pos_type seekpos( pos_type pos, std::ios_base::openmode which ) override {
+            return seekoff( off_type( pos ), std::ios_base::beg, which );
+        }
+};
+
+JsonIn::JsonIn( std::istream &s ) : stream( &s ) {}
+
+JsonIn::JsonIn( std::istream &s, const std::string &path )
+    : stream( &s ), path( make_shared_fast<std::string>( path ) ) {}
+
+JsonIn::JsonIn( std::istream &s, const json_source_location &loc )
+    : stream( &s ), path( loc.path )
+{
+    seek( loc.offset );
+}
+
+JsonIn::JsonIn( std::string_view data )
+    : buffer( std::make_unique<buffer_source>( data ) ), stream( &buffer->stream ) {}
+
+JsonIn::JsonIn( std::string_view data, const std::string &path )
+    : buffer( std::make_unique<buffer_source>( data ) ), stream( &buffer->stream ),
+      path( make_shared_fast<std::string>( path ) ) {}
+
+JsonIn::~JsonIn() = default;
+
 int JsonIn::tell()
 {
     return stream->tellg();
@@ -831,6 +912,13 @@ void JsonIn::seek( int pos )
 
 void JsonIn::eat_whitespace()
 {
+    if( buffer && stream->good() ) {
+        const char *p = buffer->cursor();
+        while( p != buffer->end() && is_whitespace( *p ) ) {
+            ++p;
+        }
+        buffer->advance_to( p );
+    }
     while( is_whitespace( peek() ) ) {
         stream->get();
     }
@@ -907,10 +995,38 @@ void JsonIn::skip_pair_separator()
     ate_separator = true;
 }
 
+// If the next value is a string of printable ASCII without escapes, as nearly all are,
+// returns its closing quote. Otherwise returns nullptr and leaves it to the general code.
+const char *JsonIn::plain_string_end()
+{
+    if( !buffer || !stream->good() ) {
+        return nullptr;
+    }
+    const char *begin = buffer->cursor();
+    const char *end = buffer->end();
+    if( begin == end || *begin != '"' ) {
+        return nullptr;
+    }
+    const char *quote = static_cast<const char *>( std::memchr( begin + 1, '"', end - begin - 1 ) );
+    if( quote == nullptr ) {
+        return nullptr;
+    }
+    const bool plain = std::all_of( begin + 1, quote, []( char ch ) {
+        const unsigned char uc = static_cast<unsigned char>( ch );
+        return uc >= 0x20 && uc < 0x80 && ch != '\\';
+    } );
+    return plain ? quote : nullptr;
+}
+
 void JsonIn::skip_string()
 {
     char ch;
     eat_whitespace();
+    if( const char *quote = plain_string_end() ) {
+        buffer->advance_to( quote + 1 );
+        end_value();
+        return;
+    }
     stream->get( ch );
     if( ch != '"' ) {
         std::stringstream err;
@@ -1020,15 +1136,27 @@ void JsonIn::skip_null()
     end_value();
 }
 
+static bool is_number_char( char ch )
+{
+    return ch == '+' || ch == '-' || ( ch >= '0' && ch <= '9' ) ||
+           ch == 'e' || ch == 'E' || ch == '.';
+}
+
 void JsonIn::skip_number()
 {
     char ch;
     eat_whitespace();
+    if( buffer && stream->good() ) {
+        const char *p = buffer->cursor();
+        while( p != buffer->end() && is_number_char( *p ) ) {
+            ++p;
+        }
+        buffer->advance_to( p );
+    }
     // skip all of (+-0123456789.eE)
     while( stream->good() ) {
         stream->get( ch );
-        if( ch != '+' && ch != '-' && ( ch < '0' || ch > '9' ) &&
-            ch != 'e' && ch != 'E' && ch != '.' ) {
+        if( !is_number_char( ch ) ) {
             stream->unget();
             break;
         }
@@ -1180,6 +1308,12 @@ static bool get_escaped_or_unicode( std::istream &stream, std::string &s, std::s
 std::string JsonIn::get_string()
 {
     eat_whitespace();
+    if( const char *quote = plain_string_end() ) {
+        std::string s( buffer->cursor() + 1, quote );
+        buffer->advance_to( quote + 1 );
+        end_value();
+        return s;
+    }
     std::string s;
     char ch;
     std::string err;
@@ -2310,10 +2444,10 @@ JsonIn &JsonValue::seek() const
 
 JsonValue JsonObject::get_member( const std::string &name ) const
 {
-    const auto iter = positions.find( name );
-    if( !jsin || iter == positions.end() ) {
+    const member_position *member = find_member( name );
+    if( !jsin || member == nullptr ) {
         throw_error( "missing required field \"" + name + "\" in object: " + str() );
     }
-    mark_visited( name );
-    return JsonValue( *jsin, iter->second );
+    mark_visited( *member );
+    return JsonValue( *jsin, member->position );
 }
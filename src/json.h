@@ -6,9 +6,11 @@
 #include <cstdint>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -166,6 +168,9 @@ struct number_sci_notation {
 class JsonIn
 {
     private:
+        class buffer_source;
+        // Set when reading from a buffer, which lets the hot paths scan it directly
+        std::unique_ptr<buffer_source> buffer;
         std::istream *stream;
         shared_ptr_fast<std::string> path;
         bool ate_separator = false;
@@ -173,17 +178,19 @@ class JsonIn
         void skip_separator();
         void skip_pair_separator();
         void end_value();
+        const char *plain_string_end();
 
     public:
-        JsonIn( std::istream &s ) : stream( &s ) {}
-        JsonIn( std::istream &s, const std::string &path )
-            : stream( &s ), path( make_shared_fast<std::string>( path ) ) {}
-        JsonIn( std::istream &s, const json_source_location &loc )
-            : stream( &s ), path( loc.path ) {
-            seek( loc.offset );
-        }
+        JsonIn( std::istream &s );
+        JsonIn( std::istream &s, const std::string &path );
+        JsonIn( std::istream &s, const json_source_location &loc );
+        // Read from a buffer holding the whole document, which must outlive this.
+        // Much faster than going through a stream.
+        explicit JsonIn( std::string_view data );
+        JsonIn( std::string_view data, const std::string &path );
         JsonIn( const JsonIn & ) = delete;
         JsonIn &operator=( const JsonIn & ) = delete;
+        ~JsonIn();
 
         shared_ptr_fast<std::string> get_path() const {
             return path;
@@ -906,16 +913,24 @@ class JsonOut
 class JsonObject
 {
     private:
-        std::map<std::string, int> positions;
+        struct member_position {
+            std::string name;
+            int position;
+            mutable bool visited = false;
+        };
+        // Sorted by name. Objects rarely have more than a few dozen members, so a flat vector
+        // needs a handful of allocations where a map would need one per member.
+        std::vector<member_position> positions;
         int start;
         int end_;
         bool final_separator = false;
 #ifndef CATA_IN_TOOL
-        mutable std::set<std::string> visited_members;
         mutable bool report_unvisited_members = true;
         mutable bool reported_unvisited_members = false;
 #endif
+        const member_position *find_member( const std::string &name ) const;
         void mark_visited( const std::string &name ) const;
+        void mark_visited( const member_position &member ) const;
         void report_unvisited() const;
 
         JsonIn *jsin;
@@ -1383,8 +1398,8 @@ class JsonObject::const_iterator
             return *this;
         }
         JsonMember operator*() const {
-            object_.mark_visited( iter_->first );
-            return JsonMember( iter_->first, JsonValue( *object_.jsin, iter_->second ) );
+            object_.mark_visited( *iter_ );
+            return JsonMember( iter_->name, JsonValue( *object_.jsin, iter_->position ) );
         }
 
         friend bool operator==( const const_iterator &lhs, const const_iterator &rhs ) {
@@ -1,6 +1,9 @@
 #include "legacy_pathfinding.h"
 
 #include <algorithm>
+#include <bitset>
+#include <climits>
+#include <cstdint>
 #include <cstdlib>
 #include <algorithm>
 #include <optional>
@@ -26,6 +29,11 @@
 #include "type_id.h"
 #include "point.h"
 
+// Should be much bigger - low value makes pathfinders dumb!
+static constexpr int route_padding = 16;
+
+static constexpr auto non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
+
 enum astar_state {
     ASL_NONE,
     ASL_OPEN,
@@ -39,43 +47,143 @@ constexpr int flat_index( const tripoint &p )
 }
 
 // Flattened 2D array representing a single z-level worth of pathfinding data
+// Entries left over from earlier routes are told apart by their generation,
+//   so the layer never needs to be cleared between routes
 struct path_data_layer {
+    // Generation of the route currently using this layer
+    std::uint32_t current = 0;
+    std::array< std::uint32_t, MAPSIZE_X *MAPSIZE_Y > generation;
     // State is accessed way more often than all other values here
     std::array< astar_state, MAPSIZE_X *MAPSIZE_Y > state;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > score;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > gscore;
     std::array< tripoint, MAPSIZE_X *MAPSIZE_Y > parent;
 
-    void init( point min, point max ) {
-        tripoint p;
-        for( p.x = min.x; p.x <= max.x; p.x++ ) {
-            for( p.y = min.y; p.y <= max.y; p.y++ ) {
-                const int ind = flat_index( p );
-                state[ind] = ASL_NONE; // Mark as unvisited
-            }
+    // Entries untouched by the current route read as unvisited with zero scores
+    astar_state get_state( const int index ) const {
+        return generation[index] == current ? state[index] : ASL_NONE;
+    }
+    int get_score( const int index ) const {
+        return generation[index] == current ? score[index] : 0;
+    }
+    int get_gscore( const int index ) const {
+        return generation[index] == current ? gscore[index] : 0;
+    }
+
+    void touch( const int index ) {
+        if( generation[index] != current ) {
+            generation[index] = current;
+            state[index] = ASL_NONE;
+            score[index] = 0;
+            gscore[index] = 0;
         }
     }
+
+    void set_state( const int index, const astar_state new_state ) {
+        touch( index );
+        state[index] = new_state;
+    }
 };
 
+// Priority queue over small non-negative integer scores, with one bucket per score
+// Points with equal scores come out last in, first out,
+//   which is as good as the unspecified order of equal scores in a heap
+class bucket_queue
+{
+    private:
+        std::vector<std::vector<tripoint>> buckets;
+        // No bucket below this one holds any points
+        int lowest = 0;
+        // Highest bucket used since the last clear
+        int highest = -1;
+        size_t count = 0;
+
+    public:
+        bool empty() const {
+            return count == 0;
+        }
+
+        void clear() {
+            for( int i = 0; i <= highest; i++ ) {
+                buckets[i].clear();
+            }
+            lowest = 0;
+            highest = -1;
+            count = 0;
+        }
+
+        void emplace( int score, const tripoint &p ) {
+            score = std::max( score, 0 );
+            if( static_cast<size_t>( score ) >= buckets.size() ) {
+                buckets.resize( score + 1 );
+            }
+            buckets[score].push_back( p );
+            lowest = std::min( lowest, score );
+            highest = std::max( highest, score );
+            count++;
+        }
+
+        tripoint pop() {
+            while( buckets[lowest].empty() ) {
+                lowest++;
+            }
+            const tripoint p = buckets[lowest].back();
+            buckets[lowest].pop_back();
+            count--;
+            return p;
+        }
+};
+
+// Reused between routes, so that its buffers are allocated only once
 struct pathfinder {
-    point min;
-    point max;
-    pathfinder( point _min, point _max ) :
-        min( _min ), max( _max ) {
-    }
+    // Layers kept between routes, about half a megabyte each. Most routes stay on one z-level
+    //   or the ones next to it, layers beyond that are freed again after the route.
+    static constexpr size_t max_kept_layers = 3;
 
-    std::priority_queue< std::pair<int, tripoint>, std::vector< std::pair<int, tripoint> >, pair_greater_cmp_first >
-    open;
+    std::uint32_t generation = 0;
+    bucket_queue open;
     std::array< std::unique_ptr< path_data_layer >, OVERMAP_LAYERS > path_data;
 
+    // Free the least recently used layers beyond `max_kept_layers`
+    void trim_layers() {
+        size_t kept = 0;
+        for( const auto &ptr : path_data ) {
+            kept += ptr != nullptr;
+        }
+        for( ; kept > max_kept_layers; kept-- ) {
+            std::unique_ptr< path_data_layer > *oldest = nullptr;
+            for( auto &ptr : path_data ) {
+                if( ptr != nullptr && ( oldest == nullptr || ptr->current < ( *oldest )->current ) ) {
+                    oldest = &ptr;
+                }
+            }
+            oldest->reset();
+        }
+    }
+
+    // Forget the previous route
+    void reset() {
+        open.clear();
+        trim_layers();
+        generation++;
+        if( generation == 0 ) {
+            // Wrapped around, old entries could pass for current ones
+            for( auto &ptr : path_data ) {
+                if( ptr != nullptr ) {
+                    ptr->generation.fill( 0 );
+                }
+            }
+            generation = 1;
+        }
+    }
+
     path_data_layer &get_layer( const int z ) {
         std::unique_ptr< path_data_layer > &ptr = path_data[z + OVERMAP_DEPTH];
-        if( ptr != nullptr ) {
-            return *ptr;
+        if( ptr == nullptr ) {
+            ptr = std::make_unique<path_data_layer>();
         }
 
-        ptr = std::make_unique<path_data_layer>();
-        ptr->init( min, max );
+        ptr->current = generation;
         return *ptr;
     }
 
@@ -84,20 +192,18 @@ struct pathfinder {
     }
 
     tripoint get_next() {
-        const auto pt = open.top();
-        open.pop();
-        return pt.second;
+        return open.pop();
     }
 
     void add_point( const int gscore, const int score, const tripoint &from, const tripoint &to ) {
         auto &layer = get_layer( to.z );
         const int index = flat_index( to );
-        if( ( layer.state[index] == ASL_OPEN && gscore >= layer.gscore[index] ) ||
-            layer.state[index] == ASL_CLOSED ) {
+        const astar_state state = layer.get_state( index );
+        if( ( state == ASL_OPEN && gscore >= layer.gscore[index] ) || state == ASL_CLOSED ) {
             return;
         }
 
-        layer.state [index] = ASL_OPEN;
+        layer.set_state( index, ASL_OPEN );
         layer.gscore[index] = gscore;
         layer.parent[index] = from;
         layer.score [index] = score;
@@ -105,15 +211,11 @@ struct pathfinder {
     }
 
     void close_point( const tripoint &p ) {
-        auto &layer = get_layer( p.z );
-        const int index = flat_index( p );
-        layer.state[index] = ASL_CLOSED;
+        get_layer( p.z ).set_state( flat_index( p ), ASL_CLOSED );
     }
 
     void unclose_point( const tripoint &p ) {
-        auto &layer = get_layer( p.z );
-        const int index = flat_index( p );
-        layer.state[index] = ASL_NONE;
+        get_layer( p.z ).set_state( flat_index( p ), ASL_NONE );
     }
 };
 
@@ -213,7 +315,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     }
     // First, check for a simple straight line on flat ground
     // Except when the line contains a pre-closed tile - we need to do regular pathing then
-    static const auto non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
     if( f.z == t.z ) {
         const auto line_path = line_to( f, t );
         const auto &pf_cache = get_pathfinding_cache_ref( f.z );
@@ -235,6 +336,314 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         return ret;
     }
 
+    // Routes between submaps are first planned over the regions of the submaps,
+    // so that the tile search only has to look at the submaps the route passes
+    if( f.z == t.z && ( f.x / SEEX != t.x / SEEX || f.y / SEEY != t.y / SEEY ) ) {
+        std::bitset<MAPSIZE *MAPSIZE> corridor;
+        if( !plan_route_corridor( f, t, settings, corridor ) ) {
+            return ret;
+        }
+        if( corridor.any() ) {
+            ret = route_tiles( f, t, settings, pre_closed, &corridor );
+            if( !ret.empty() ) {
+                return ret;
+            }
+        }
+    }
+
+    return route_tiles( f, t, settings, pre_closed, nullptr );
+}
+
+bool map::route_may_enter( const tripoint &p, const pathfinding_settings &settings ) const
+{
+    // Same as the checks closing tiles in route_tiles, but erring on the side of enterable
+    const pf_special p_special = get_pathfinding_cache_ref( p.z ).special[p.x][p.y];
+    if( !( p_special & non_normal ) ) {
+        return true;
+    }
+    if( settings.avoid_rough_terrain || ( settings.avoid_sharp && p_special & PF_SHARP ) ) {
+        return false;
+    }
+
+    int part = -1;
+    const vehicle *veh = veh_at_internal( p, part );
+    const maptile &tile = maptile_at_internal( p );
+    const auto &terrain = tile.get_ter_t();
+    const auto &furniture = tile.get_furn_t();
+    if( veh != nullptr || move_cost_internal( furniture, terrain, veh, part ) != 0 ) {
+        return true;
+    }
+    if( settings.bash_strength > 0 &&
+        bash_rating_internal( settings.bash_strength, furniture, terrain, false, veh, part ) > 0 ) {
+        return true;
+    }
+    if( settings.climb_cost > 0 ) {
+        return p_special & PF_CLIMBABLE ||
+               ( settings.allow_open_doors && ( terrain.open || furniture.open ) );
+    }
+
+    return settings.allow_open_doors && terrain.open && furniture.open;
+}
+
+pathfinding_regions::pathfinding_regions()
+{
+    std::uninitialized_fill_n( &region[0][0], MAPSIZE_X * MAPSIZE_Y, 0 );
+    dirty_regions.set();
+    dirty_portals.set();
+}
+
+pathfinding_regions &pathfinding_cache::get_regions( const pathfinding_class &pclass )
+{
+    // Bash strength differs between most NPCs, don't keep the regions of all of them around
+    static constexpr size_t max_classes = 8;
+    if( regions.size() >= max_classes && !regions.contains( pclass ) ) {
+        regions.clear();
+    }
+
+    return regions[pclass];
+}
+
+bool map::plan_route_corridor( const tripoint &f, const tripoint &t,
+                               const pathfinding_settings &settings,
+                               std::bitset<MAPSIZE *MAPSIZE> &corridor ) const
+{
+    const int z = f.z;
+    pathfinding_class pclass;
+    pclass.bash_strength = settings.bash_strength;
+    pclass.allow_open_doors = settings.allow_open_doors;
+    pclass.climb = settings.climb_cost > 0;
+    pclass.avoid_rough_terrain = settings.avoid_rough_terrain;
+    pclass.avoid_sharp = settings.avoid_sharp;
+    // Brings special up to date, which in turn dirties the regions of changed submaps
+    get_pathfinding_cache_ref( z );
+    pathfinding_regions &regions = get_pathfinding_cache( z ).get_regions( pclass );
+
+    const auto sm_index = []( point sm ) {
+        return static_cast<size_t>( sm.x + sm.y * MAPSIZE );
+    };
+    const auto in_map = [this]( point sm ) {
+        return sm.x >= 0 && sm.y >= 0 && sm.x < my_MAPSIZE && sm.y < my_MAPSIZE;
+    };
+
+    // Splits the tiles of a submap into 8-connected regions of tiles a route may enter
+    std::vector<point> stack;
+    const auto label = [&]( point sm ) {
+        const size_t index = sm_index( sm );
+        if( !regions.dirty_regions[index] ) {
+            return;
+        }
+
+        const point origin( sm.x * SEEX, sm.y * SEEY );
+        std::vector<point> &centers = regions.centers[index];
+        centers.clear();
+        std::bitset<SEEX *SEEY> visited;
+        for( int lx = 0; lx < SEEX; lx++ ) {
+            for( int ly = 0; ly < SEEY; ly++ ) {
+                regions.region[origin.x + lx][origin.y + ly] = 0;
+            }
+        }
+        for( int lx = 0; lx < SEEX; lx++ ) {
+            for( int ly = 0; ly < SEEY; ly++ ) {
+                const point start = origin + point( lx, ly );
+                if( visited[lx + ly * SEEX] ) {
+                    continue;
+                }
+                visited.set( lx + ly * SEEX );
+                if( !route_may_enter( tripoint( start, z ), settings ) ) {
+                    continue;
+                }
+
+                const auto id = static_cast<std::uint8_t>( centers.size() + 1 );
+                point sum;
+                int count = 0;
+                regions.region[start.x][start.y] = id;
+                stack.push_back( start );
+                while( !stack.empty() ) {
+                    const point cur = stack.back();
+                    stack.pop_back();
+                    sum += cur;
+                    count++;
+                    for( const point &offset : eight_adjacent_offsets ) {
+                        const point next = cur + offset;
+                        const point local = next - origin;
+                        if( local.x < 0 || local.y < 0 || local.x >= SEEX || local.y >= SEEY ||
+                            visited[local.x + local.y * SEEX] ) {
+                            continue;
+                        }
+                        visited.set( local.x + local.y * SEEX );
+                        if( route_may_enter( tripoint( next, z ), settings ) ) {
+                            regions.region[next.x][next.y] = id;
+                            stack.push_back( next );
+                        }
+                    }
+                }
+                centers.emplace_back( sum.x / count, sum.y / count );
+            }
+        }
+
+        regions.dirty_regions.reset( index );
+        // Portals of this submap and its neighbours refer to the old regions
+        for( int dx = -1; dx <= 1; dx++ ) {
+            for( int dy = -1; dy <= 1; dy++ ) {
+                const point neighbour = sm + point( dx, dy );
+                if( in_map( neighbour ) ) {
+                    regions.dirty_portals.set( sm_index( neighbour ) );
+                }
+            }
+        }
+    };
+
+    // Finds the regions of neighbouring submaps touching the regions of this submap
+    const auto connect = [&]( point sm ) -> const std::vector<pathfinding_regions::portal> & {
+        const size_t index = sm_index( sm );
+        std::vector<pathfinding_regions::portal> &portals = regions.portals[index];
+        if( !regions.dirty_portals[index] ) {
+            return portals;
+        }
+
+        for( int dx = -1; dx <= 1; dx++ ) {
+            for( int dy = -1; dy <= 1; dy++ ) {
+                const point neighbour = sm + point( dx, dy );
+                if( in_map( neighbour ) ) {
+                    label( neighbour );
+                }
+            }
+        }
+
+        portals.clear();
+        const point origin( sm.x * SEEX, sm.y * SEEY );
+        for( int lx = 0; lx < SEEX; lx++ ) {
+            for( int ly = 0; ly < SEEY; ly++ ) {
+                if( lx != 0 && ly != 0 && lx != SEEX - 1 && ly != SEEY - 1 ) {
+                    continue;
+                }
+                const point p = origin + point( lx, ly );
+                const std::uint8_t from = regions.region[p.x][p.y];
+                if( from == 0 ) {
+                    continue;
+                }
+                for( const point &offset : eight_adjacent_offsets ) {
+                    const point next = p + offset;
+                    const point next_sm( divide_round_down( next.x, SEEX ),
+                                         divide_round_down( next.y, SEEY ) );
+                    if( next_sm == sm || !in_map( next_sm ) ) {
+                        continue;
+                    }
+                    const std::uint8_t to = regions.region[next.x][next.y];
+                    const int to_submap = static_cast<int>( sm_index( next_sm ) );
+                    if( to == 0 || std::ranges::any_of( portals, [&]( const auto & portal ) {
+                    return portal.from == from && portal.to_submap == to_submap && portal.to == to;
+                } ) ) {
+                        continue;
+                    }
+                    const int cost = 2 * rl_dist( regions.centers[index][from - 1],
+                                                  regions.centers[to_submap][to - 1] );
+                    portals.push_back( { from, to_submap, to, std::max( cost, 1 ) } );
+                }
+            }
+        }
+
+        regions.dirty_portals.reset( index );
+        return portals;
+    };
+
+    const point f_sm( f.x / SEEX, f.y / SEEY );
+    const point t_sm( t.x / SEEX, t.y / SEEY );
+    label( f_sm );
+    label( t_sm );
+    const std::uint8_t f_region = regions.region[f.x][f.y];
+    const std::uint8_t t_region = regions.region[t.x][t.y];
+    if( f_region == 0 || t_region == 0 ) {
+        // Leave routes from or to tiles the regions consider blocked to the tile search
+        return true;
+    }
+
+    // Same area as the tile search
+    const point min_sm( std::max( std::min( f.x, t.x ) - route_padding, 0 ) / SEEX,
+                        std::max( std::min( f.y, t.y ) - route_padding, 0 ) / SEEY );
+    const point max_sm( std::min( std::max( f.x, t.x ) + route_padding, SEEX * my_MAPSIZE - 1 ) / SEEX,
+                        std::min( std::max( f.y, t.y ) + route_padding, SEEY * my_MAPSIZE - 1 ) / SEEY );
+
+    // A* over (submap, region) nodes
+    // 8-connected regions of a submap are at least two tiles apart, so there are at most 36
+    static constexpr int max_regions = 64;
+    const auto node_of = []( size_t index, std::uint8_t region ) {
+        return static_cast<int>( index ) * max_regions + region;
+    };
+    std::vector<int> gscore( MAPSIZE * MAPSIZE * max_regions, INT_MAX );
+    std::vector<int> parent( MAPSIZE * MAPSIZE * max_regions, -1 );
+    std::priority_queue< std::pair<int, int>, std::vector< std::pair<int, int> >, pair_greater_cmp_first >
+    open;
+    const int start = node_of( sm_index( f_sm ), f_region );
+    const int goal = node_of( sm_index( t_sm ), t_region );
+    gscore[start] = 0;
+    open.emplace( 2 * rl_dist( regions.centers[sm_index( f_sm )][f_region - 1], t.xy() ), start );
+    bool found = false;
+    while( !open.empty() ) {
+        const auto [score, node] = open.top();
+        open.pop();
+        if( node == goal ) {
+            found = true;
+            break;
+        }
+
+        const int index = node / max_regions;
+        const int region = node % max_regions;
+        const point sm( index % MAPSIZE, index / MAPSIZE );
+        const int center_dist = 2 * rl_dist( regions.centers[index][region - 1], t.xy() );
+        if( score > gscore[node] + center_dist ) {
+            // Already expanded with a better score
+            continue;
+        }
+
+        for( const pathfinding_regions::portal &portal : connect( sm ) ) {
+            const point to_sm( portal.to_submap % MAPSIZE, portal.to_submap / MAPSIZE );
+            if( portal.from != region || to_sm.x < min_sm.x || to_sm.y < min_sm.y ||
+                to_sm.x > max_sm.x || to_sm.y > max_sm.y ) {
+                continue;
+            }
+            const int next = node_of( portal.to_submap, portal.to );
+            const int newg = gscore[node] + portal.cost;
+            if( newg >= gscore[next] ) {
+                continue;
+            }
+            gscore[next] = newg;
+            parent[next] = node;
+            const point &center = regions.centers[portal.to_submap][portal.to - 1];
+            open.emplace( newg + 2 * rl_dist( center, t.xy() ), next );
+        }
+    }
+
+    if( !found ) {
+        // Ledges let routes avoiding traps drop a z-level and come back up elsewhere,
+        // which the regions of a single z-level don't know about
+        return settings.avoid_traps && has_zlevels();
+    }
+
+    // Let the tile search cut corners through the submaps next to the planned ones
+    for( int node = goal; node != -1; node = parent[node] ) {
+        const int index = node / max_regions;
+        const point sm( index % MAPSIZE, index / MAPSIZE );
+        for( int dx = -1; dx <= 1; dx++ ) {
+            for( int dy = -1; dy <= 1; dy++ ) {
+                const point neighbour = sm + point( dx, dy );
+                if( in_map( neighbour ) ) {
+                    corridor.set( sm_index( neighbour ) );
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+std::vector<tripoint> map::route_tiles( const tripoint &f, const tripoint &t,
+                                        const pathfinding_settings &settings,
+                                        const std::set<tripoint> &pre_closed,
+                                        const std::bitset<MAPSIZE *MAPSIZE> *corridor ) const
+{
+    std::vector<tripoint> ret;
+
     int max_length = settings.max_length;
     int bash = settings.bash_strength;
     int climb_cost = settings.climb_cost;
@@ -243,19 +652,19 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     bool roughavoid = settings.avoid_rough_terrain;
     bool sharpavoid = settings.avoid_sharp;
 
-    const int pad = 16;  // Should be much bigger - low value makes pathfinders dumb!
-    int minx = std::min( f.x, t.x ) - pad;
-    int miny = std::min( f.y, t.y ) - pad;
+    int minx = std::min( f.x, t.x ) - route_padding;
+    int miny = std::min( f.y, t.y ) - route_padding;
     // TODO: Make this way bigger
     int minz = std::min( f.z, t.z );
-    int maxx = std::max( f.x, t.x ) + pad;
-    int maxy = std::max( f.y, t.y ) + pad;
+    int maxx = std::max( f.x, t.x ) + route_padding;
+    int maxy = std::max( f.y, t.y ) + route_padding;
     // Same TODO: as above
     int maxz = std::max( f.z, t.z );
     clip_to_bounds( minx, miny, minz );
     clip_to_bounds( maxx, maxy, maxz );
 
-    pathfinder pf( point( minx, miny ), point( maxx, maxy ) );
+    static thread_local pathfinder pf;
+    pf.reset();
     // Make NPCs not want to path through player
     // But don't make player pathing stop working
     for( const auto &p : pre_closed ) {
@@ -276,12 +685,11 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
         const int parent_index = flat_index( cur );
         auto &layer = pf.get_layer( cur.z );
-        auto &cur_state = layer.state[parent_index];
-        if( cur_state == ASL_CLOSED ) {
+        if( layer.get_state( parent_index ) == ASL_CLOSED ) {
             continue;
         }
 
-        if( layer.gscore[parent_index] > max_length ) {
+        if( layer.get_gscore( parent_index ) > max_length ) {
             // Shortest path would be too long, return empty vector
             return std::vector<tripoint>();
         }
@@ -291,7 +699,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             break;
         }
 
-        cur_state = ASL_CLOSED;
+        layer.set_state( parent_index, ASL_CLOSED );
 
         const auto &pf_cache = get_pathfinding_cache_ref( cur.z );
         const auto cur_special = pf_cache.special[cur.x][cur.y];
@@ -313,7 +721,11 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                 continue;
             }
 
-            if( layer.state[index] == ASL_CLOSED ) {
+            if( corridor != nullptr && !( *corridor )[p.x / SEEX + ( p.y / SEEY ) * MAPSIZE] ) {
+                continue;
+            }
+
+            if( layer.get_state( index ) == ASL_CLOSED ) {
                 continue;
             }
 
@@ -332,7 +744,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             }
 
             // Penalize for diagonals or the path will look "unnatural"
-            int newg = layer.gscore[parent_index] + ( ( cur.x != p.x && cur.y != p.y ) ? 1 : 0 );
+            int newg = layer.get_gscore( parent_index ) + ( ( cur.x != p.x && cur.y != p.y ) ? 1 : 0 );
 
             const auto p_special = pf_cache.special[p.x][p.y];
             // TODO: De-uglify, de-huge-n
@@ -341,7 +753,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                 newg += 2;
             } else {
                 if( roughavoid ) {
-                    layer.state[index] = ASL_CLOSED; // Close all rough terrain tiles
+                    layer.set_state( index, ASL_CLOSED ); // Close all rough terrain tiles
                     continue;
                 }
 
@@ -356,7 +768,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
                 if( cost == 0 && rating <= 0 && ( !doors || !terrain.open || !furniture.open ) && veh == nullptr &&
                     climb_cost <= 0 ) {
-                    layer.state[index] = ASL_CLOSED; // Close it so that next time we won't try to calculate costs
+                    layer.set_state( index, ASL_CLOSED ); // Close it so that next time we won't try to calculate costs
                     continue;
                 }
 
@@ -386,7 +798,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                             int hp = veh->cpart( part ).hp();
                             if( hp / 20 > bash ) {
                                 // Threshold damage thing means we just can't bash this down
-                                layer.state[index] = ASL_CLOSED;
+                                layer.set_state( index, ASL_CLOSED );
                                 continue;
                             } else if( hp / 10 > bash ) {
                                 // Threshold damage thing means we will fail to deal damage pretty often
@@ -397,7 +809,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                         } else if( part >= 0 ) {
                             if( !doors || !veh->part_flag( part, VPFLAG_OPENABLE ) ) {
                                 // Won't be openable, don't try from other sides
-                                layer.state[index] = ASL_CLOSED;
+                                layer.set_state( index, ASL_CLOSED );
                             }
 
                             continue;
@@ -413,7 +825,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                         // Unbashable and unopenable from here
                         if( !doors || !terrain.open || !furniture.open ) {
                             // Or anywhere else for that matter
-                            layer.state[index] = ASL_CLOSED;
+                            layer.set_state( index, ASL_CLOSED );
                         }
 
                         continue;
@@ -434,13 +846,13 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                                     // Otherwise this would have been a huge fall
                                     auto &layer = pf.get_layer( p.z - 1 );
                                     // From cur, not p, because we won't be walking on air
-                                    pf.add_point( layer.gscore[parent_index] + 10,
-                                                  layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
+                                    pf.add_point( layer.get_gscore( parent_index ) + 10,
+                                                  layer.get_score( parent_index ) + 10 + 2 * rl_dist( below, t ),
                                                   cur, below );
                                 }
 
                                 // Close p, because we won't be walking on it
-                                layer.state[index] = ASL_CLOSED;
+                                layer.set_state( index, ASL_CLOSED );
                                 continue;
                             }
                         } else if( trapavoid ) {
@@ -451,14 +863,14 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                 }
 
                 if( sharpavoid && p_special & PF_SHARP ) {
-                    layer.state[index] = ASL_CLOSED; // Avoid sharp things
+                    layer.set_state( index, ASL_CLOSED ); // Avoid sharp things
                 }
 
             }
 
             // If not visited, add as open
             // If visited, add it only if we can do so with better score
-            if( layer.state[index] == ASL_NONE || newg < layer.gscore[index] ) {
+            if( layer.get_state( index ) == ASL_NONE || newg < layer.get_gscore( index ) ) {
                 pf.add_point( newg, newg + 2 * rl_dist( p, t ), cur, p );
             }
         }
@@ -474,8 +886,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             tripoint dest( cur.xy(), cur.z - 1 );
             if( vertical_move_destination<TFLAG_GOES_UP>( *this, dest ) ) {
                 auto &layer = pf.get_layer( dest.z );
-                pf.add_point( layer.gscore[parent_index] + 2,
-                              layer.score[parent_index] + 2 * rl_dist( dest, t ),
+                pf.add_point( layer.get_gscore( parent_index ) + 2,
+                              layer.get_score( parent_index ) + 2 * rl_dist( dest, t ),
                               cur, dest );
             }
         }
@@ -483,8 +895,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             tripoint dest( cur.xy(), cur.z + 1 );
             if( vertical_move_destination<TFLAG_GOES_DOWN>( *this, dest ) ) {
                 auto &layer = pf.get_layer( dest.z );
-                pf.add_point( layer.gscore[parent_index] + 2,
-                              layer.score[parent_index] + 2 * rl_dist( dest, t ),
+                pf.add_point( layer.get_gscore( parent_index ) + 2,
+                              layer.get_score( parent_index ) + 2 * rl_dist( dest, t ),
                               cur, dest );
             }
         }
@@ -493,8 +905,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             auto &layer = pf.get_layer( cur.z + 1 );
             for( size_t it = 0; it < 8; it++ ) {
                 const tripoint above( cur.x + x_offset[it], cur.y + y_offset[it], cur.z + 1 );
-                pf.add_point( layer.gscore[parent_index] + 4,
-                              layer.score[parent_index] + 4 + 2 * rl_dist( above, t ),
+                pf.add_point( layer.get_gscore( parent_index ) + 4,
+                              layer.get_score( parent_index ) + 4 + 2 * rl_dist( above, t ),
                               cur, above );
             }
         }
@@ -503,8 +915,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             auto &layer = pf.get_layer( cur.z + 1 );
             for( size_t it = 0; it < 8; it++ ) {
                 const tripoint above( cur.x + x_offset[it], cur.y + y_offset[it], cur.z + 1 );
-                pf.add_point( layer.gscore[parent_index] + 4,
-                              layer.score[parent_index] + 4 + 2 * rl_dist( above, t ),
+                pf.add_point( layer.get_gscore( parent_index ) + 4,
+                              layer.get_score( parent_index ) + 4 + 2 * rl_dist( above, t ),
                               cur, above );
             }
         }
@@ -513,8 +925,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             auto &layer = pf.get_layer( cur.z - 1 );
             for( size_t it = 0; it < 8; it++ ) {
                 const tripoint below( cur.x + x_offset[it], cur.y + y_offset[it], cur.z - 1 );
-                pf.add_point( layer.gscore[parent_index] + 4,
-                              layer.score[parent_index] + 4 + 2 * rl_dist( below, t ),
+                pf.add_point( layer.get_gscore( parent_index ) + 4,
+                              layer.get_score( parent_index ) + 4 + 2 * rl_dist( below, t ),
                               cur, below );
             }
         }
@@ -1,6 +1,13 @@
 #pragma once
 
+#include <bitset>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+
 #include "game_constants.h"
+#include "point.h"
 
 enum pf_special : int {
     PF_NORMAL = 0x00,    // Plain boring tile (grass, dirt, floor etc.)
@@ -36,13 +43,62 @@ inline pf_special &operator &= ( pf_special &lhs, pf_special rhs )
     return lhs;
 }
 
+/**
+ * The part of @ref pathfinding_settings that decides which tiles a route could ever step on.
+ * Routes with the same class share their @ref pathfinding_regions.
+ */
+struct pathfinding_class {
+    int bash_strength = 0;
+    bool allow_open_doors = false;
+    bool climb = false;
+    bool avoid_rough_terrain = false;
+    bool avoid_sharp = false;
+
+    bool operator<( const pathfinding_class &rhs ) const {
+        return std::tie( bash_strength, allow_open_doors, climb, avoid_rough_terrain, avoid_sharp ) <
+               std::tie( rhs.bash_strength, rhs.allow_open_doors, rhs.climb, rhs.avoid_rough_terrain,
+                         rhs.avoid_sharp );
+    }
+};
+
+/**
+ * Connected areas of tiles a route could step on, labelled separately in each submap,
+ * and the portals linking them to the areas of neighbouring submaps.
+ * Long routes are planned over those before being refined tile by tile.
+ */
+struct pathfinding_regions {
+    struct portal {
+        std::uint8_t from;
+        int to_submap;
+        std::uint8_t to;
+        int cost;
+    };
+
+    pathfinding_regions();
+
+    // Region of each tile within its submap, starting at 1. 0 for tiles no route can enter.
+    std::uint8_t region[MAPSIZE_X][MAPSIZE_Y];
+    // Average position of the tiles of each region of a submap
+    std::vector<point> centers[MAPSIZE * MAPSIZE];
+    std::vector<portal> portals[MAPSIZE * MAPSIZE];
+
+    std::bitset<MAPSIZE *MAPSIZE> dirty_regions;
+    std::bitset<MAPSIZE *MAPSIZE> dirty_portals;
+};
+
 struct pathfinding_cache {
     pathfinding_cache();
     ~pathfinding_cache() = default;
 
     bool dirty;
+    // Submaps whose part of special needs to be rebuilt
+    std::bitset<MAPSIZE *MAPSIZE> dirty_submaps;
 
     pf_special special[MAPSIZE_X][MAPSIZE_Y];
+
+    std::map<pathfinding_class, pathfinding_regions> regions;
+
+    pathfinding_regions &get_regions( const pathfinding_class &pclass );
 };
 
 struct pathfinding_settings {
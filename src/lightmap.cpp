@@ -22,6 +22,7 @@
 #include "int_id.h"
 #include "item.h"
 #include "item_stack.h"
+#include "lightmap_kernels.h"
 #include "line.h"
 #include "map.h"
 #include "map_iterator.h"
@@ -103,7 +104,7 @@ void map::add_light_from_items( const tripoint &p, const item_stack::iterator &b
 }
 
 // TODO: Consider making this just clear the cache and dynamically fill it in as is_transparent() is called
-bool map::build_transparency_cache( const int zlev )
+bool map::build_transparency_cache( const int zlev, const float sight_penalty )
 {
     auto &map_cache = get_cache( zlev );
     auto &transparency_cache = map_cache.transparency_cache;
@@ -124,13 +125,6 @@ bool map::build_transparency_cache( const int zlev )
                                    static_cast<float>( LIGHT_TRANSPARENCY_OPEN_AIR ) );
     }
 
-    const float sight_penalty = get_weather().weather_id->sight_penalty;
-
-    if( sight_penalty != 1.0f &&
-        LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty != weather_transparency_lookup.transparency ) {
-        weather_transparency_lookup.reset( LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty );
-    }
-
     // Traverse the submaps in order
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
@@ -185,15 +179,12 @@ bool map::build_transparency_cache( const int zlev )
                     for( int sy = 0; sy < SEEY; ++sy ) {
                         const int y = sy + sm_offset.y;
                         transparency_cache[x][y] = calc_transp( { x, y } );
-
-                        //Nudge things towards fast paths
-                        if( std::fabs( transparency_cache[x][y] - openair_transparency_lookup.transparency ) <= 0.0001 ) {
-                            transparency_cache[x][y] = openair_transparency_lookup.transparency;
-                        } else if( std::fabs( transparency_cache[x][y] - weather_transparency_lookup.transparency ) <=
-                                   0.0001 ) {
-                            transparency_cache[x][y] = weather_transparency_lookup.transparency;
-                        }
                     }
+
+                    //Nudge things towards fast paths
+                    lightmap_kernels::snap_transparency( &transparency_cache[x][sm_offset.y], SEEY,
+                                                         openair_transparency_lookup.transparency,
+                                                         weather_transparency_lookup.transparency );
                 }
             }
         }
@@ -202,6 +193,14 @@ bool map::build_transparency_cache( const int zlev )
     return true;
 }
 
+void map::update_weather_transparency_lookup( const float sight_penalty )
+{
+    if( sight_penalty != 1.0f &&
+        LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty != weather_transparency_lookup.transparency ) {
+        weather_transparency_lookup.reset( LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty );
+    }
+}
+
 bool map::build_vision_transparency_cache( const Character &player )
 {
     const tripoint &p = player.pos();
@@ -346,20 +345,14 @@ void map::build_sunlight_cache( int pzlev )
 
             const auto &this_floor_cache = map_cache.floor_cache;
             const auto &this_transparency_cache = map_cache.transparency_cache;
-            fully_inside = true; // recalculate
-
-            for( int x = 0; x < MAPSIZE_X; ++x ) {
-                for( int y = 0; y < MAPSIZE_Y; ++y ) {
-                    // && semantics below is important, we want to skip the evaluation if possible, do not replace with &=
-
-                    // fully_outside stays true if tile is transparent and there is no floor
-                    fully_outside = fully_outside && this_transparency_cache[x][y] >= LIGHT_TRANSPARENCY_OPEN_AIR
-                                    && !this_floor_cache[x][y];
-                    // fully_inside stays true if tile is opaque OR there is floor
-                    fully_inside = fully_inside && ( this_transparency_cache[x][y] <= LIGHT_TRANSPARENCY_SOLID ||
-                                                     this_floor_cache[x][y] );
-                }
-            }
+
+            // fully_outside stays true if every tile is transparent and there is no floor
+            fully_outside = lightmap_kernels::all_open_to_sky( &this_transparency_cache[0][0],
+                            &this_floor_cache[0][0], MAPSIZE_X * MAPSIZE_Y );
+            // fully_inside stays true if every tile is opaque OR there is floor
+            fully_inside = !fully_outside &&
+                           lightmap_kernels::all_shut_off( &this_transparency_cache[0][0],
+                                   &this_floor_cache[0][0], MAPSIZE_X * MAPSIZE_Y );
             continue;
         }
 
@@ -391,6 +384,11 @@ void map::build_sunlight_cache( int pzlev )
         // Fall back to minimal light level if we don't find anything.
         std::fill_n( &lm[0][0], MAPSIZE_X * MAPSIZE_Y, four_quadrants( inside_light_level ) );
 
+        // Light that makes it through each tile of the level above, 0 where it's blocked.
+        float prev_light[MAPSIZE_X][MAPSIZE_Y];
+        lightmap_kernels::light_from_above( &prev_transparency_cache[0][0], &prev_floor_cache[0][0],
+                                            &prev_lm[0][0], &prev_light[0][0], MAPSIZE_X * MAPSIZE_Y );
+
         for( int x = 0; x < MAPSIZE_X; ++x ) {
             for( int y = 0; y < MAPSIZE_Y; ++y ) {
                 // Check center, then four adjacent cardinals.
@@ -404,17 +402,14 @@ void map::build_sunlight_cache( int pzlev )
                         continue;
                     }
 
-                    float prev_light_max;
-                    float prev_transparency = prev_transparency_cache[prev_x][prev_y];
-                    // This is pretty gross, this cancels out the per-tile transparency effect
-                    // derived from weather.
-                    if( outside_cache[x][y] ) {
-                        prev_transparency /= sight_penalty;
-                    }
-
-                    if( prev_transparency > LIGHT_TRANSPARENCY_SOLID &&
-                        !prev_floor_cache[prev_x][prev_y] &&
-                        ( prev_light_max = prev_lm[prev_x][prev_y].max() ) > 0.0 ) {
+                    const float prev_light_max = prev_light[prev_x][prev_y];
+                    if( prev_light_max > 0.0 ) {
+                        float prev_transparency = prev_transparency_cache[prev_x][prev_y];
+                        // This is pretty gross, this cancels out the per-tile transparency effect
+                        // derived from weather.
+                        if( outside_cache[x][y] ) {
+                            prev_transparency /= sight_penalty;
+                        }
                         const float light_level = clamp( prev_light_max * LIGHT_TRANSPARENCY_OPEN_AIR / prev_transparency,
                                                          inside_light_level, prev_light_max );
 
@@ -636,11 +631,24 @@ void map::generate_lightmap( const int zlev )
         unbuffered: (12^2)*(160*4) = apply_light_ray x 92160
         buffered:   (12*4)*(160)   = apply_light_ray x 7680
     */
+    /* Most of them won't have moved or changed since last turn either, so the rays they cast
+       then are reused unless the transparency around them has changed in the meantime.
+    */
+    update_light_input_versions( zlev );
     const tripoint cache_start( 0, 0, zlev );
     const tripoint cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
     for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
         if( light_source_buffer[p.x][p.y] > 0.0 ) {
-            apply_light_source( p, light_source_buffer[p.x][p.y] );
+            apply_buffered_light_source( p, light_source_buffer[p.x][p.y] );
+        }
+    }
+    // Forget the sources that have gone out
+    auto &contributions = map_cache.light_source_contributions;
+    for( auto iter = contributions.begin(); iter != contributions.end(); ) {
+        if( light_source_buffer[iter->first.x][iter->first.y] > 0.0 ) {
+            ++iter;
+        } else {
+            iter = contributions.erase( iter );
         }
     }
     for( const std::pair<tripoint, float> &elem : lm_override ) {
@@ -1749,24 +1757,36 @@ static float light_from_lookup( const float &numerator, const float &transparenc
     return numerator *  transparency  / distance ;
 }
 
-void map::apply_light_source( const tripoint &p, float luminance )
+namespace
+{
+enum light_direction : int {
+    light_north = 1 << 0,
+    light_east = 1 << 1,
+    light_south = 1 << 2,
+    light_west = 1 << 3,
+};
+} // namespace
+
+/**
+ * Light the tile of a source at @p p and work out which directions its rays need to be cast into.
+ * @return Bitmask of light_direction, zero if no rays are to be cast at all.
+ */
+static int light_source_directions( level_cache &cache, const tripoint &p, bool inbounds,
+                                    float &luminance )
 {
-    auto &cache = get_cache( p.z );
     four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
     float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
-    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
     float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
-    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.vehicle_obscured_cache;
 
     const point p2( p.xy() );
 
-    if( inbounds( p ) ) {
+    if( inbounds ) {
         const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
         lm[p2.x][p2.y] = elementwise_max( lm[p2.x][p2.y], min_light );
         sm[p2.x][p2.y] = std::max( sm[p2.x][p2.y], luminance );
     }
     if( luminance <= lit_level::LOW ) {
-        return;
+        return 0;
     } else if( luminance <= lit_level::BRIGHT_ONLY ) {
         luminance = 1.49f;
     }
@@ -1788,12 +1808,29 @@ void map::apply_light_source( const tripoint &p, float luminance )
            sy
     */
     const int peer_inbounds = LIGHTMAP_CACHE_X - 1;
-    bool north = ( p2.y != 0 && light_source_buffer[p2.x][p2.y - 1] < luminance );
-    bool south = ( p2.y != peer_inbounds && light_source_buffer[p2.x][p2.y + 1] < luminance );
-    bool east = ( p2.x != peer_inbounds && light_source_buffer[p2.x + 1][p2.y] < luminance );
-    bool west = ( p2.x != 0 && light_source_buffer[p2.x - 1][p2.y] < luminance );
+    int directions = 0;
+    if( p2.y != 0 && light_source_buffer[p2.x][p2.y - 1] < luminance ) {
+        directions |= light_north;
+    }
+    if( p2.x != peer_inbounds && light_source_buffer[p2.x + 1][p2.y] < luminance ) {
+        directions |= light_east;
+    }
+    if( p2.y != peer_inbounds && light_source_buffer[p2.x][p2.y + 1] < luminance ) {
+        directions |= light_south;
+    }
+    if( p2.x != 0 && light_source_buffer[p2.x - 1][p2.y] < luminance ) {
+        directions |= light_west;
+    }
+    return directions;
+}
+
+static void cast_light_source( four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                               const level_cache &cache, point p2, float luminance, int directions )
+{
+    const float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
+    const diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.vehicle_obscured_cache;
 
-    if( north ) {
+    if( directions & light_north ) {
         castLightWithLookup < 1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
@@ -1802,7 +1839,7 @@ void map::apply_light_source( const tripoint &p, float luminance )
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     }
 
-    if( east ) {
+    if( directions & light_east ) {
         castLightWithLookup < 0, -1, 1, 0, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
@@ -1811,7 +1848,7 @@ void map::apply_light_source( const tripoint &p, float luminance )
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     }
 
-    if( south ) {
+    if( directions & light_south ) {
         castLightWithLookup<1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup>(
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
@@ -1820,7 +1857,7 @@ void map::apply_light_source( const tripoint &p, float luminance )
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     }
 
-    if( west ) {
+    if( directions & light_west ) {
         castLightWithLookup<0, 1, 1, 0, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup>(
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
@@ -1830,6 +1867,104 @@ void map::apply_light_source( const tripoint &p, float luminance )
     }
 }
 
+void map::apply_light_source( const tripoint &p, float luminance )
+{
+    auto &cache = get_cache( p.z );
+    const int directions = light_source_directions( cache, p, inbounds( p ), luminance );
+    if( directions != 0 ) {
+        cast_light_source( cache.lm, cache, p.xy(), luminance, directions );
+    }
+}
+
+void map::update_light_input_versions( const int zlev )
+{
+    auto &cache = get_cache( zlev );
+    for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            const point sm_offset = sm_to_ms_copy( point( smx, smy ) );
+            bool changed = false;
+            for( int x = sm_offset.x; x < sm_offset.x + SEEX && !changed; ++x ) {
+                changed = std::memcmp( &cache.transparency_cache[x][sm_offset.y],
+                                       &cache.light_transparency_snapshot[x][sm_offset.y],
+                                       SEEY * sizeof( float ) ) != 0 ||
+                          std::memcmp( &cache.vehicle_obscured_cache[x][sm_offset.y],
+                                       &cache.light_obscured_snapshot[x][sm_offset.y],
+                                       SEEY * sizeof( diagonal_blocks ) ) != 0;
+            }
+            if( !changed ) {
+                continue;
+            }
+            cache.light_input_version[smx * MAPSIZE + smy] = ++cache.light_input_clock;
+            for( int x = sm_offset.x; x < sm_offset.x + SEEX; ++x ) {
+                std::copy_n( &cache.transparency_cache[x][sm_offset.y], SEEY,
+                             &cache.light_transparency_snapshot[x][sm_offset.y] );
+                std::copy_n( &cache.vehicle_obscured_cache[x][sm_offset.y], SEEY,
+                             &cache.light_obscured_snapshot[x][sm_offset.y] );
+            }
+        }
+    }
+}
+
+void map::apply_buffered_light_source( const tripoint &p, float luminance )
+{
+    auto &cache = get_cache( p.z );
+    const point p2( p.xy() );
+    const int directions = light_source_directions( cache, p, inbounds( p ), luminance );
+    if( directions == 0 ) {
+        cache.light_source_contributions.erase( p2 );
+        return;
+    }
+
+    light_source_contribution &contribution = cache.light_source_contributions[p2];
+    const auto reach = [&p2]( int radius ) {
+        return half_open_rectangle<point>(
+                   point( std::max( p2.x - radius, 0 ), std::max( p2.y - radius, 0 ) ),
+                   point( std::min( p2.x + radius + 1, LIGHTMAP_CACHE_X ),
+                          std::min( p2.y + radius + 1, LIGHTMAP_CACHE_Y ) ) );
+    };
+
+    // The rays only depend on the transparency of the tiles they lit, or were stopped by.
+    bool valid = contribution.luminance == luminance && contribution.directions == directions;
+    const half_open_rectangle<point> depends_on = reach( contribution.radius );
+    for( int smx = depends_on.p_min.x / SEEX; valid && smx <= ( depends_on.p_max.x - 1 ) / SEEX;
+         ++smx ) {
+        for( int smy = depends_on.p_min.y / SEEY; valid && smy <= ( depends_on.p_max.y - 1 ) / SEEY;
+             ++smy ) {
+            valid = cache.light_input_version[smx * MAPSIZE + smy] <= contribution.cast_at;
+        }
+    }
+
+    if( !valid ) {
+        // Cast into an empty scratch lightmap to pick out the tiles this source lights.
+        static four_quadrants scratch[MAPSIZE_X][MAPSIZE_Y];
+        cast_light_source( scratch, cache, p2, luminance, directions );
+
+        contribution.luminance = luminance;
+        contribution.directions = directions;
+        contribution.cast_at = cache.light_input_clock;
+        contribution.radius = 1;
+        contribution.lit.clear();
+        constexpr four_quadrants four_zeros( 0.0f );
+        // Shadowcasting never goes further than 60 tiles.
+        const half_open_rectangle<point> cast_area = reach( 60 );
+        for( int x = cast_area.p_min.x; x < cast_area.p_max.x; ++x ) {
+            for( int y = cast_area.p_min.y; y < cast_area.p_max.y; ++y ) {
+                if( scratch[x][y].max() > 0.0f ) {
+                    contribution.lit.emplace_back( point( x, y ), scratch[x][y] );
+                    contribution.radius = std::max( contribution.radius,
+                                                    square_dist( p2, point( x, y ) ) + 1 );
+                    scratch[x][y] = four_zeros;
+                }
+            }
+        }
+    }
+
+    auto &lm = cache.lm;
+    for( const std::pair<point, four_quadrants> &elem : contribution.lit ) {
+        lm[elem.first.x][elem.first.y] = elementwise_max( lm[elem.first.x][elem.first.y], elem.second );
+    }
+}
+
 void map::apply_directional_light( const tripoint &p, int direction, float luminance )
 {
     const point p2( p.xy() );
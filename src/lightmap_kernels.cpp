@@ -0,0 +1,284 @@
+#include "lightmap_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define LIGHTMAP_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace lightmap_kernels
+{
+namespace scalar
+{
+
+void snap_transparency( float *values, int count, float open_air, float weather )
+{
+    for( int i = 0; i < count; ++i ) {
+        if( std::fabs( values[i] - open_air ) <= 0.0001 ) {
+            values[i] = open_air;
+        } else if( std::fabs( values[i] - weather ) <= 0.0001 ) {
+            values[i] = weather;
+        }
+    }
+}
+
+void light_from_above( const float *transparency, const bool *floor, const four_quadrants *lm,
+                       float *out, int count )
+{
+    for( int i = 0; i < count; ++i ) {
+        out[i] = transparency[i] > LIGHT_TRANSPARENCY_SOLID && !floor[i] ? lm[i].max() : 0.0f;
+    }
+}
+
+bool all_open_to_sky( const float *transparency, const bool *floor, int count )
+{
+    for( int i = 0; i < count; ++i ) {
+        if( transparency[i] < LIGHT_TRANSPARENCY_OPEN_AIR || floor[i] ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool all_shut_off( const float *transparency, const bool *floor, int count )
+{
+    for( int i = 0; i < count; ++i ) {
+        if( transparency[i] > LIGHT_TRANSPARENCY_SOLID && !floor[i] ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int classify_visibility( const float *seen, const float *camera, const four_quadrants *lm,
+                         const float *sm, const float *transparency, float g_light_level,
+                         float vision_threshold, lit_level *out, int count )
+{
+    int opaque_visible = 0;
+    for( int i = 0; i < count; ++i ) {
+        const float vis = std::max( seen[i], camera[i] );
+        const float apparent_light = vis * lm[i].max();
+        if( transparency[i] <= LIGHT_TRANSPARENCY_SOLID && vis > 0 ) {
+            opaque_visible++;
+        }
+
+        if( vis <= LIGHT_TRANSPARENCY_SOLID + 0.1 ) {
+            if( apparent_light > LIGHT_AMBIENT_LIT ) {
+                out[i] = apparent_light > g_light_level ? lit_level::BRIGHT_ONLY : lit_level::LOW;
+            } else {
+                out[i] = lit_level::BLANK;
+            }
+        } else if( apparent_light > LIGHT_SOURCE_BRIGHT || sm[i] > 0.0 ) {
+            out[i] = lit_level::BRIGHT;
+        } else if( apparent_light > LIGHT_AMBIENT_LIT ) {
+            out[i] = lit_level::LIT;
+        } else if( apparent_light >= vision_threshold ) {
+            out[i] = lit_level::LOW;
+        } else {
+            out[i] = lit_level::BLANK;
+        }
+    }
+    return opaque_visible;
+}
+
+} // namespace scalar
+
+#if defined(LIGHTMAP_KERNELS_SSE2)
+
+namespace
+{
+
+/** Four bools widened to 32 bit lanes holding 0 or 1. */
+__m128i load_bools( const bool *p )
+{
+    int32_t packed;
+    std::memcpy( &packed, p, sizeof( packed ) );
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bytes = _mm_cvtsi32_si128( packed );
+    return _mm_unpacklo_epi16( _mm_unpacklo_epi8( bytes, zero ), zero );
+}
+
+/** All bits set in the lanes where the bool is false. */
+__m128 bools_false( const bool *p )
+{
+    return _mm_castsi128_ps( _mm_cmpeq_epi32( load_bools( p ), _mm_setzero_si128() ) );
+}
+
+/** The brightest quadrant of each of four consecutive tiles. */
+__m128 max_quadrants( const four_quadrants *lm )
+{
+    __m128 a = _mm_loadu_ps( lm[0].values.data() );
+    __m128 b = _mm_loadu_ps( lm[1].values.data() );
+    __m128 c = _mm_loadu_ps( lm[2].values.data() );
+    __m128 d = _mm_loadu_ps( lm[3].values.data() );
+    _MM_TRANSPOSE4_PS( a, b, c, d );
+    return _mm_max_ps( _mm_max_ps( a, b ), _mm_max_ps( c, d ) );
+}
+
+__m128 select( __m128 mask, __m128 if_set, __m128 if_clear )
+{
+    return _mm_or_ps( _mm_and_ps( mask, if_set ), _mm_andnot_ps( mask, if_clear ) );
+}
+
+__m128i select( __m128 mask, __m128i if_set, __m128i if_clear )
+{
+    const __m128i m = _mm_castps_si128( mask );
+    return _mm_or_si128( _mm_and_si128( m, if_set ), _mm_andnot_si128( m, if_clear ) );
+}
+
+__m128i lit_levels( lit_level ll )
+{
+    return _mm_set1_epi32( static_cast<int>( ll ) );
+}
+
+int popcount4( int mask )
+{
+    return ( mask & 1 ) + ( ( mask >> 1 ) & 1 ) + ( ( mask >> 2 ) & 1 ) + ( ( mask >> 3 ) & 1 );
+}
+
+} // namespace
+
+void snap_transparency( float *values, int count, float open_air, float weather )
+{
+    const __m128 sign = _mm_set1_ps( -0.0f );
+    // 0.0001f rounds down, so it is the largest float not above the 0.0001 (a double)
+    // the scalar version compares with
+    const __m128 epsilon = _mm_set1_ps( 0.0001f );
+    const __m128 v_open_air = _mm_set1_ps( open_air );
+    const __m128 v_weather = _mm_set1_ps( weather );
+    int i = 0;
+    for( ; i + 4 <= count; i += 4 ) {
+        const __m128 v = _mm_loadu_ps( values + i );
+        const __m128 near_open_air = _mm_cmple_ps( _mm_andnot_ps( sign, _mm_sub_ps( v, v_open_air ) ),
+                                     epsilon );
+        const __m128 near_weather = _mm_cmple_ps( _mm_andnot_ps( sign, _mm_sub_ps( v, v_weather ) ),
+                                    epsilon );
+        _mm_storeu_ps( values + i, select( near_open_air, v_open_air,
+                                           select( near_weather, v_weather, v ) ) );
+    }
+    scalar::snap_transparency( values + i, count - i, open_air, weather );
+}
+
+void light_from_above( const float *transparency, const bool *floor, const four_quadrants *lm,
+                       float *out, int count )
+{
+    const __m128 solid = _mm_set1_ps( LIGHT_TRANSPARENCY_SOLID );
+    int i = 0;
+    for( ; i + 4 <= count; i += 4 ) {
+        const __m128 passes = _mm_and_ps( _mm_cmpgt_ps( _mm_loadu_ps( transparency + i ), solid ),
+                                          bools_false( floor + i ) );
+        _mm_storeu_ps( out + i, _mm_and_ps( passes, max_quadrants( lm + i ) ) );
+    }
+    scalar::light_from_above( transparency + i, floor + i, lm + i, out + i, count - i );
+}
+
+bool all_open_to_sky( const float *transparency, const bool *floor, int count )
+{
+    const __m128 open_air = _mm_set1_ps( LIGHT_TRANSPARENCY_OPEN_AIR );
+    int i = 0;
+    for( ; i + 4 <= count; i += 4 ) {
+        const __m128 open = _mm_and_ps( _mm_cmpge_ps( _mm_loadu_ps( transparency + i ), open_air ),
+                                        bools_false( floor + i ) );
+        if( _mm_movemask_ps( open ) != 0xF ) {
+            return false;
+        }
+    }
+    return scalar::all_open_to_sky( transparency + i, floor + i, count - i );
+}
+
+bool all_shut_off( const float *transparency, const bool *floor, int count )
+{
+    const __m128 solid = _mm_set1_ps( LIGHT_TRANSPARENCY_SOLID );
+    int i = 0;
+    for( ; i + 4 <= count; i += 4 ) {
+        const __m128 passes = _mm_and_ps( _mm_cmpgt_ps( _mm_loadu_ps( transparency + i ), solid ),
+                                          bools_false( floor + i ) );
+        if( _mm_movemask_ps( passes ) != 0 ) {
+            return false;
+        }
+    }
+    return scalar::all_shut_off( transparency + i, floor + i, count - i );
+}
+
+int classify_visibility( const float *seen, const float *camera, const four_quadrants *lm,
+                         const float *sm, const float *transparency, float g_light_level,
+                         float vision_threshold, lit_level *out, int count )
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 solid = _mm_set1_ps( LIGHT_TRANSPARENCY_SOLID );
+    // 0.1f rounds up, so vis < 0.1f holds for exactly the floats that are <= 0.1 as a double
+    const __m128 obstructed_below = _mm_set1_ps( static_cast<float>( LIGHT_TRANSPARENCY_SOLID + 0.1 ) );
+    const __m128 ambient_lit = _mm_set1_ps( LIGHT_AMBIENT_LIT );
+    const __m128 source_bright = _mm_set1_ps( LIGHT_SOURCE_BRIGHT );
+    const __m128 v_g_light_level = _mm_set1_ps( g_light_level );
+    const __m128 v_vision_threshold = _mm_set1_ps( vision_threshold );
+    const __m128i bright = lit_levels( lit_level::BRIGHT );
+    const __m128i bright_only = lit_levels( lit_level::BRIGHT_ONLY );
+    const __m128i lit = lit_levels( lit_level::LIT );
+    const __m128i low = lit_levels( lit_level::LOW );
+    const __m128i blank = lit_levels( lit_level::BLANK );
+
+    int opaque_visible = 0;
+    int i = 0;
+    for( ; i + 4 <= count; i += 4 ) {
+        const __m128 vis = _mm_max_ps( _mm_loadu_ps( seen + i ), _mm_loadu_ps( camera + i ) );
+        const __m128 apparent_light = _mm_mul_ps( vis, max_quadrants( lm + i ) );
+        const __m128 opaque = _mm_cmple_ps( _mm_loadu_ps( transparency + i ), solid );
+        opaque_visible += popcount4( _mm_movemask_ps( _mm_and_ps( opaque,
+                                     _mm_cmpgt_ps( vis, zero ) ) ) );
+
+        const __m128 above_lit = _mm_cmpgt_ps( apparent_light, ambient_lit );
+        const __m128i obstructed_level = select( above_lit,
+                                         select( _mm_cmpgt_ps( apparent_light, v_g_light_level ), bright_only, low ),
+                                         blank );
+        const __m128 is_bright = _mm_or_ps( _mm_cmpgt_ps( apparent_light, source_bright ),
+                                            _mm_cmpgt_ps( _mm_loadu_ps( sm + i ), zero ) );
+        const __m128i clear_level = select( is_bright, bright,
+                                            select( above_lit, lit,
+                                                    select( _mm_cmpge_ps( apparent_light, v_vision_threshold ), low, blank ) ) );
+        const __m128 obstructed = _mm_cmplt_ps( vis, obstructed_below );
+        _mm_storeu_si128( reinterpret_cast<__m128i *>( out + i ),
+                          select( obstructed, obstructed_level, clear_level ) );
+    }
+    return opaque_visible + scalar::classify_visibility( seen + i, camera + i, lm + i, sm + i,
+            transparency + i, g_light_level, vision_threshold, out + i, count - i );
+}
+
+#else
+
+void snap_transparency( float *values, int count, float open_air, float weather )
+{
+    scalar::snap_transparency( values, count, open_air, weather );
+}
+
+void light_from_above( const float *transparency, const bool *floor, const four_quadrants *lm,
+                       float *out, int count )
+{
+    scalar::light_from_above( transparency, floor, lm, out, count );
+}
+
+bool all_open_to_sky( const float *transparency, const bool *floor, int count )
+{
+    return scalar::all_open_to_sky( transparency, floor, count );
+}
+
+bool all_shut_off( const float *transparency, const bool *floor, int count )
+{
+    return scalar::all_shut_off( transparency, floor, count );
+}
+
+int classify_visibility( const float *seen, const float *camera, const four_quadrants *lm,
+                         const float *sm, const float *transparency, float g_light_level,
+                         float vision_threshold, lit_level *out, int count )
+{
+    return scalar::classify_visibility( seen, camera, lm, sm, transparency, g_light_level,
+                                        vision_threshold, out, count );
+}
+
+#endif
+
+} // namespace lightmap_kernels
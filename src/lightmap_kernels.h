@@ -0,0 +1,59 @@
+#pragma once
+
+#include "lightmap.h"
+#include "shadowcasting.h"
+
+/**
+ * Bulk per-tile passes used when building the light related caches of a map level.
+ *
+ * They work on a run of consecutive tiles, usually one row of a `level_cache` array.
+ * On x86 they are vectorized with SSE2, which every 64 bit x86 build has; elsewhere they
+ * fall back to the plain loops in @ref lightmap_kernels::scalar, which give identical results.
+ */
+namespace lightmap_kernels
+{
+
+/**
+ * Replaces transparency values within 0.0001 of @p open_air or @p weather with that exact
+ * value, so shadowcasting can take its lookup table fast paths for them.
+ */
+void snap_transparency( float *values, int count, float open_air, float weather );
+
+/**
+ * Brightest light on each tile that can shine down to the level below, or 0 for tiles
+ * that are opaque or have a floor.
+ */
+void light_from_above( const float *transparency, const bool *floor, const four_quadrants *lm,
+                       float *out, int count );
+
+/** True if every tile is at least as transparent as open air and has no floor. */
+bool all_open_to_sky( const float *transparency, const bool *floor, int count );
+
+/** True if every tile is opaque or has a floor. */
+bool all_shut_off( const float *transparency, const bool *floor, int count );
+
+/**
+ * The lit_level of each tile as seen by the player, for tiles the player is neither
+ * clairvoyant about nor too far away to see, see @ref map::apparent_light_at.
+ * Opaque tiles that are visible get light from only some of their quadrants, which needs
+ * their neighbours; their results have to be recomputed by the caller.
+ * @return The number of such opaque visible tiles.
+ */
+int classify_visibility( const float *seen, const float *camera, const four_quadrants *lm,
+                         const float *sm, const float *transparency, float g_light_level,
+                         float vision_threshold, lit_level *out, int count );
+
+/** The reference implementations, always available for testing and benchmarking. */
+namespace scalar
+{
+void snap_transparency( float *values, int count, float open_air, float weather );
+void light_from_above( const float *transparency, const bool *floor, const four_quadrants *lm,
+                       float *out, int count );
+bool all_open_to_sky( const float *transparency, const bool *floor, int count );
+bool all_shut_off( const float *transparency, const bool *floor, int count );
+int classify_visibility( const float *seen, const float *camera, const four_quadrants *lm,
+                         const float *sm, const float *transparency, float g_light_level,
+                         float vision_threshold, lit_level *out, int count );
+} // namespace scalar
+
+} // namespace lightmap_kernels
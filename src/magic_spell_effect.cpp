@@ -680,7 +680,7 @@ static void move_field( map &here, const tripoint &from, const tripoint &to )
 {
     field &src_field = here.field_at( from );
     std::map<field_type_id, int> moving_fields;
-    for( const std::pair<const field_type_id, field_entry> &fd : src_field ) {
+    for( const std::pair<field_type_id, field_entry> &fd : src_field ) {
         if( fd.first.is_valid() && !fd.first.id().is_null() ) {
             const int intensity = fd.second.get_field_intensity();
             moving_fields.emplace( fd.first, intensity );
@@ -242,7 +242,7 @@ int main( int argc, char *argv[] )
         const char *section_default = nullptr;
         const char *section_map_sharing = "Map sharing";
         const char *section_user_directory = "User directories";
-        const std::array<arg_handler, 15> first_pass_arguments = {{
+        const std::array<arg_handler, 16> first_pass_arguments = {{
                 {
                     "--seed", "<string of letters and or numbers>",
                     "Sets the random number generator's seed value",
@@ -421,6 +421,15 @@ int main( int argc, char *argv[] )
                         return 0;
                     }
                 },
+                {
+                    "--skip-verified-data-checks", nullptr,
+                    "Skips the consistency checks of game data this version already checked without errors; the data is still loaded as usual",
+                    section_default,
+                    []( int, const char ** ) -> int {
+                        skip_verified_data_checks = true;
+                        return 0;
+                    }
+                },
                 {
                     "--lua-doc", "<output path>",
                     "Generate Lua docs to given path and exit",
@@ -6,12 +6,14 @@
 #include <climits>
 #include <cstdlib>
 #include <cstring>
+#include <future>
 #include <limits>
 #include <optional>
 #include <ostream>
 #include <queue>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "active_item_cache.h"
 #include "ammo.h"
@@ -19,6 +21,7 @@
 #include "artifact.h"
 #include "avatar.h"
 #include "bodypart.h"
+#include "cached_options.h"
 #include "calendar.h"
 #include "cata_utility.h"
 #include "character.h"
@@ -57,6 +60,7 @@
 #include "iuse.h"
 #include "iuse_actor.h"
 #include "lightmap.h"
+#include "lightmap_kernels.h"
 #include "line.h"
 #include "map_functions.h"
 #include "map_iterator.h"
@@ -75,6 +79,7 @@
 #include "output.h"
 #include "overmapbuffer.h"
 #include "legacy_pathfinding.h"
+#include "pathfinding.h"
 #include "player.h"
 #include "point_float.h"
 #include "projectile.h"
@@ -86,6 +91,7 @@
 #include "string_formatter.h"
 #include "string_id.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "timed_event.h"
 #include "translations.h"
@@ -263,6 +269,21 @@ void map::set_transparency_cache_dirty( const tripoint &p )
     }
 }
 
+void map::set_scent_cache_dirty( const int zlev )
+{
+    if( inbounds_z( zlev ) ) {
+        get_cache( zlev ).scent_transfer_dirty.set();
+    }
+}
+
+void map::set_scent_cache_dirty( const tripoint &p )
+{
+    if( inbounds( p ) ) {
+        const tripoint smp = ms_to_sm_copy( p );
+        get_cache( smp.z ).scent_transfer_dirty.set( smp.x * MAPSIZE + smp.y );
+    }
+}
+
 static submap null_submap( tripoint_zero );
 
 maptile map::maptile_at( const tripoint &p ) const
@@ -1515,12 +1536,16 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture,
         set_floor_cache_dirty( p.z + 1 );
     }
 
+    if( old_t.has_flag( TFLAG_REDUCE_SCENT ) != new_t.has_flag( TFLAG_REDUCE_SCENT ) ) {
+        set_scent_cache_dirty( p );
+    }
+
     invalidate_max_populated_zlev( p.z );
 
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     // Make sure the furniture falls if it needs to
     support_dirty( p );
@@ -1622,7 +1647,7 @@ uint8_t map::get_known_connections( const tripoint &p, int connect_group,
     if( use_tiles ) {
         is_memorized =
         [&]( const tripoint & q ) {
-            return !g->u.get_memorized_tile( getabs( q ) ).tile.empty();
+            return !g->u.get_memorized_tile( getabs( q ) ).name().empty();
         };
     } else {
 #endif
@@ -1674,7 +1699,7 @@ uint8_t map::get_known_connections_f( const tripoint &p, int connect_group,
 #ifdef TILES
     if( use_tiles ) {
         is_memorized = [&]( const tripoint & q ) {
-            return !player_character.get_memorized_tile( getabs( q ) ).tile.empty();
+            return !player_character.get_memorized_tile( getabs( q ) ).name().empty();
         };
     } else {
 #endif
@@ -1851,11 +1876,16 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
         }
     }
 
+    if( old_t.has_flag( TFLAG_NO_SCENT ) != new_t.has_flag( TFLAG_NO_SCENT ) ||
+        old_t.has_flag( TFLAG_REDUCE_SCENT ) != new_t.has_flag( TFLAG_REDUCE_SCENT ) ) {
+        set_scent_cache_dirty( p );
+    }
+
     invalidate_max_populated_zlev( p.z );
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     tripoint above( p.xy(), p.z + 1 );
     // Make sure that if we supported something and no longer do so, it falls down
@@ -4837,6 +4867,7 @@ std::vector<tripoint> map::check_submap_active_item_consistency()
 
 void map::process_items()
 {
+    active_items_processed = 0;
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int gz = minz; gz <= maxz; ++gz ) {
@@ -4861,6 +4892,7 @@ void map::process_items()
             process_items_in_submap( *current_submap, local_pos );
         }
     }
+    TracyPlot( "Active items processed", static_cast<int64_t>( active_items_processed ) );
 }
 
 static temperature_flag temperature_flag_at_point( const map &m, const tripoint &p )
@@ -4884,6 +4916,7 @@ void map::process_items_in_submap( submap &current_submap, const tripoint &gridp
     // If more are added as a side effect of processing, they are ignored this turn.
     // If they are destroyed before processing, they don't get processed.
     std::vector<item *> active_items = current_submap.active_items.get_for_processing();
+    active_items_processed += static_cast<int>( active_items.size() );
     const point grid_offset( gridp.x * SEEX, gridp.y * SEEY );
     for( item *&active_item_ref : active_items ) {
         if( !active_item_ref || !active_item_ref->is_loaded() ) {
@@ -4931,7 +4964,9 @@ void map::process_items_in_vehicle( vehicle &cur_veh, submap &current_submap )
         process_vehicle_items( cur_veh, vp.part_index() );
     }
 
-    for( item *active_item_ref : cur_veh.active_items.get_for_processing() ) {
+    const std::vector<item *> active_items = cur_veh.active_items.get_for_processing();
+    active_items_processed += static_cast<int>( active_items.size() );
+    for( item *active_item_ref : active_items ) {
         if( empty( cargo_parts ) ) {
             return;
         }
@@ -5504,6 +5539,7 @@ void map::trap_set( const tripoint &p, const trap_id &type )
     if( type != tr_null ) {
         traplocs[type.to_i()].push_back( p );
     }
+    set_pathfinding_cache_dirty( p );
 }
 
 void map::disarm_trap( const tripoint &p )
@@ -5585,6 +5621,7 @@ void map::remove_trap( const tripoint &p )
         if( iter != traps.end() ) {
             traps.erase( iter );
         }
+        set_pathfinding_cache_dirty( p );
     }
 }
 /*
@@ -5735,6 +5772,7 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
             get_cache( p.z ).field_cache.set( static_cast<size_t>( p.x / SEEX + ( (
                                                   p.y / SEEX ) * MAPSIZE ) ) );
         }
+        list_field_tile( p );
     }
 
     if( hit_player ) {
@@ -5752,7 +5790,7 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
     }
 
     if( fd_type.is_dangerous() ) {
-        set_pathfinding_cache_dirty( p.z );
+        set_pathfinding_cache_dirty( p );
     }
 
     // Ensure blood type fields don't hang in the air
@@ -5784,7 +5822,7 @@ void map::remove_field( const tripoint &p, const field_type_id &field_to_remove
             set_seen_cache_dirty( p );
         }
         if( fdata.is_dangerous() ) {
-            set_pathfinding_cache_dirty( p.z );
+            set_pathfinding_cache_dirty( p );
         }
     }
 }
@@ -5889,19 +5927,51 @@ void map::update_visibility_cache( const int zlev )
     int min_z = fov_3d ? -OVERMAP_DEPTH : zlev;
     int max_z = fov_3d ? OVERMAP_HEIGHT : zlev;
 
+    const tripoint &u_pos = g->u.pos();
+    const int unimpaired_range = g->u.unimpaired_range();
+    // Furthest distance along the row from the player's column that is still within range,
+    // -1 if none of the row is. Distance only grows moving away from the player's column.
+    const auto reach_in_row = [&u_pos]( int x, int z, int range ) {
+        int lo = -1;
+        int hi = MAPSIZE_Y;
+        while( hi - lo > 1 ) {
+            const int mid = ( lo + hi ) / 2;
+            if( rl_dist( u_pos, tripoint( x, u_pos.y + mid, z ) ) <= range ) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    };
+
     for( int z = min_z; z <= max_z; z++ ) {
 
-        auto &visibility_cache = get_cache( z ).visibility_cache;
+        auto &map_cache = get_cache( z );
+        auto &visibility_cache = map_cache.visibility_cache;
 
         tripoint p;
         p.z = z;
         int &x = p.x;
         int &y = p.y;
         for( x = 0; x < MAPSIZE_X; x++ ) {
+            // Classify the whole row as if it were all in plain sight, then go back over the
+            // tiles that aren't: those with clairvoyance or out of range, and visible opaque ones.
+            const int opaque_visible = lightmap_kernels::classify_visibility(
+                                           map_cache.seen_cache[x], map_cache.camera_cache[x], map_cache.lm[x], map_cache.sm[x],
+                                           map_cache.transparency_cache[x],
+                                           static_cast<float>( visibility_variables_cache.g_light_level ),
+                                           visibility_variables_cache.vision_threshold, visibility_cache[x], MAPSIZE_Y );
+            const int clairvoyance_reach = reach_in_row( x, z, visibility_variables_cache.u_clairvoyance );
+            const int unimpaired_reach = reach_in_row( x, z, unimpaired_range );
             for( y = 0; y < MAPSIZE_Y; y++ ) {
-                lit_level ll = apparent_light_at( p, visibility_variables_cache );
-                visibility_cache[x][y] = ll;
+                const int dy = std::abs( y - u_pos.y );
+                if( dy <= clairvoyance_reach || dy > unimpaired_reach ||
+                    ( opaque_visible > 0 && map_cache.transparency_cache[x][y] <= LIGHT_TRANSPARENCY_SOLID ) ) {
+                    visibility_cache[x][y] = apparent_light_at( p, visibility_variables_cache );
+                }
                 if( z == zlev ) {
+                    const lit_level ll = visibility_cache[x][y];
                     sm_squares_seen[ x / SEEX ][ y / SEEY ] += ( ll == lit_level::BRIGHT || ll == lit_level::LIT );
                 }
             }
@@ -6775,7 +6845,7 @@ bool map::obstructed_by_vehicle_rotation( const tripoint &from, const tripoint &
 
     point delta = to.xy() - from.xy();
 
-    auto cache = get_cache( from.z ).vehicle_obstructed_cache;
+    const auto &cache = get_cache( from.z ).vehicle_obstructed_cache;
 
     if( delta == point_north_west ) {
         return cache[from.x][from.y].nw;
@@ -7090,6 +7160,7 @@ void map::shift( point sp )
         clear_vehicle_list( gridz );
         shift_bitset_cache<MAPSIZE_X, SEEX>( get_cache( gridz ).map_memory_seen_cache, sp );
         shift_bitset_cache<MAPSIZE, 1>( get_cache( gridz ).field_cache, sp );
+        set_field_tiles_unlisted( gridz );
         if( sp.x >= 0 ) {
             for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
                 if( sp.y >= 0 ) {
@@ -7181,6 +7252,15 @@ void map::shift( point sp )
 
     g->setremoteveh( remoteveh );
 
+    if( this == &get_map() ) {
+        // Read ahead further the faster we're driving, roughly one more row per 40 mph.
+        int lookahead = 1;
+        if( const vehicle *veh = veh_pointer_or_null( veh_at( g->u.pos() ) ) ) {
+            lookahead = std::min( 1 + std::abs( veh->velocity ) / 4000, 3 );
+        }
+        MAPBUFFER.prefetch_ahead( get_abs_sub(), sp, lookahead, zmin, zmax );
+    }
+
     if( !support_cache_dirty.empty() ) {
         shift_tripoint_set( support_cache_dirty, shift_offset_pt, boundaries_2d );
     }
@@ -7319,11 +7399,13 @@ void map::loadn( const tripoint &grid, const bool update_vehicles )
     set_outside_cache_dirty( grid.z );
     set_floor_cache_dirty( grid.z );
     set_pathfinding_cache_dirty( grid.z );
+    set_scent_cache_dirty( grid.z );
     set_suspension_cache_dirty( grid.z );
     setsubmap( gridn, tmpsub );
     if( !tmpsub->active_items.empty() ) {
         submaps_with_active_items.emplace( grid_abs_sub );
     }
+    set_field_tiles_unlisted( grid );
     if( tmpsub->field_count > 0 ) {
         get_cache( grid.z ).field_cache.set( grid.x + grid.y * MAPSIZE );
     }
@@ -8596,19 +8678,40 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     bool seen_cache_dirty = false;
-    for( int z = minz; z <= maxz; z++ ) {
-        // trigger FOV recalculation only when there is a change on the player's level or if fov_3d is enabled
-        const bool affects_seen_cache =  z == zlev || fov_3d;
+    // Weather is read here, the level caches may be built on worker threads
+    const float sight_penalty = get_weather().weather_id->sight_penalty;
+    update_weather_transparency_lookup( sight_penalty );
+    // These only read the submaps and write the caches of their own level
+    const auto build_level_caches = [this, sight_penalty]( int z ) {
         build_outside_cache( z );
-        build_transparency_cache( z );
-        update_suspension_cache( z );
-        seen_cache_dirty |= ( build_floor_cache( z ) && affects_seen_cache );
-        seen_cache_dirty |= get_cache( z ).seen_cache_dirty && affects_seen_cache;
+        build_transparency_cache( z, sight_penalty );
         diagonal_blocks fill = {false, false};
         std::uninitialized_fill_n( &( get_cache( z ).vehicle_obscured_cache[0][0] ), MAPSIZE_X * MAPSIZE_Y,
                                    fill );
         std::uninitialized_fill_n( &( get_cache( z ).vehicle_obstructed_cache[0][0] ),
                                    MAPSIZE_X * MAPSIZE_Y, fill );
+    };
+    if( parallel_map_cache && maxz > minz ) {
+        std::vector<std::future<void>> levels;
+        for( int z = minz; z <= maxz; z++ ) {
+            levels.push_back( get_thread_pool().submit( [&build_level_caches, z]() {
+                build_level_caches( z );
+            } ) );
+        }
+        for( std::future<void> &level : levels ) {
+            level.get();
+        }
+    } else {
+        for( int z = minz; z <= maxz; z++ ) {
+            build_level_caches( z );
+        }
+    }
+    for( int z = minz; z <= maxz; z++ ) {
+        // trigger FOV recalculation only when there is a change on the player's level or if fov_3d is enabled
+        const bool affects_seen_cache =  z == zlev || fov_3d;
+        update_suspension_cache( z );
+        seen_cache_dirty |= ( build_floor_cache( z ) && affects_seen_cache );
+        seen_cache_dirty |= get_cache( z ).seen_cache_dirty && affects_seen_cache;
     }
     // needs a separate pass as it changes the caches on neighbour z-levels (e.g. floor_cache);
     // otherwise such changes might be overwritten by main cache-building logic
@@ -8747,6 +8850,7 @@ void map::draw_fill_background( const ter_id &type )
     set_seen_cache_dirty( abs_sub.z );
     set_outside_cache_dirty( abs_sub.z );
     set_pathfinding_cache_dirty( abs_sub.z );
+    set_scent_cache_dirty( abs_sub.z );
 
     // Fill each submap rather than each tile
     for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
@@ -8934,24 +9038,42 @@ void map::function_over( const tripoint &start, const tripoint &end, Functor fun
 void map::scent_blockers( std::array<std::array<char, MAPSIZE_X>, MAPSIZE_Y> &scent_transfer,
                           point min, point max )
 {
-    auto reduce = TFLAG_REDUCE_SCENT;
-    auto block = TFLAG_NO_SCENT;
-    auto fill_values = [&]( const tripoint & gp, const submap * sm, point  lp ) {
-        // We need to generate the x/y coordinates, because we can't get them "for free"
-        const point p = lp + sm_to_ms_copy( gp.xy() );
-        if( sm->get_ter( lp ).obj().has_flag( block ) ) {
-            scent_transfer[p.x][p.y] = 0;
-        } else if( sm->get_ter( lp ).obj().has_flag( reduce ) ||
-                   sm->get_furn( lp ).obj().has_flag( reduce ) ) {
-            scent_transfer[p.x][p.y] = 1;
-        } else {
-            scent_transfer[p.x][p.y] = 5;
+    level_cache &ch = get_cache( abs_sub.z );
+    const point sm_min( std::max( 0, min.x / SEEX ), std::max( 0, min.y / SEEY ) );
+    const point sm_max( std::min( my_MAPSIZE - 1, max.x / SEEX ),
+                        std::min( my_MAPSIZE - 1, max.y / SEEY ) );
+    for( int smx = sm_min.x; smx <= sm_max.x; smx++ ) {
+        for( int smy = sm_min.y; smy <= sm_max.y; smy++ ) {
+            if( !ch.scent_transfer_dirty[smx * MAPSIZE + smy] ) {
+                continue;
+            }
+            ch.scent_transfer_dirty.reset( smx * MAPSIZE + smy );
+
+            const submap *sm = get_submap_at_grid( tripoint( smx, smy, abs_sub.z ) );
+            for( int sx = 0; sx < SEEX; sx++ ) {
+                for( int sy = 0; sy < SEEY; sy++ ) {
+                    const point lp( sx, sy );
+                    char &value = ch.scent_transfer_cache[smx * SEEX + sx][smy * SEEY + sy];
+                    const ter_t &ter = sm->get_ter( lp ).obj();
+                    if( ter.has_flag( TFLAG_NO_SCENT ) ) {
+                        value = 0;
+                    } else if( ter.has_flag( TFLAG_REDUCE_SCENT ) ||
+                               sm->get_furn( lp ).obj().has_flag( TFLAG_REDUCE_SCENT ) ) {
+                        value = 1;
+                    } else {
+                        value = 5;
+                    }
+                }
+            }
         }
+    }
 
-        return ITER_CONTINUE;
-    };
-
-    function_over( tripoint( min, abs_sub.z ), tripoint( max, abs_sub.z ), fill_values );
+    const int copy_min_y = std::max( 0, min.y );
+    const int copy_max_y = std::min( SEEY * my_MAPSIZE - 1, max.y );
+    for( int x = std::max( 0, min.x ); x <= std::min( SEEX * my_MAPSIZE - 1, max.x ); x++ ) {
+        std::copy_n( &ch.scent_transfer_cache[x][copy_min_y], copy_max_y - copy_min_y + 1,
+                     &scent_transfer[x][copy_min_y] );
+    }
 
     const inclusive_rectangle<point> local_bounds( min, max );
 
@@ -9162,17 +9284,23 @@ level_cache::level_cache()
 {
     const int map_dimensions = MAPSIZE_X * MAPSIZE_Y;
     transparency_cache_dirty.set();
+    scent_transfer_dirty.set();
+    field_tiles_unlisted.set();
     outside_cache_dirty = true;
     floor_cache_dirty = false;
     constexpr four_quadrants four_zeros( 0.0f );
     std::fill_n( &lm[0][0], map_dimensions, four_zeros );
     std::fill_n( &sm[0][0], map_dimensions, 0.0f );
     std::fill_n( &light_source_buffer[0][0], map_dimensions, 0.0f );
+    light_input_version.fill( 0 );
+    std::fill_n( &light_transparency_snapshot[0][0], map_dimensions, 0.0f );
     std::fill_n( &outside_cache[0][0], map_dimensions, false );
     std::fill_n( &floor_cache[0][0], map_dimensions, false );
     std::fill_n( &transparency_cache[0][0], map_dimensions, 0.0f );
+    std::fill_n( &scent_transfer_cache[0][0], map_dimensions, 5 );
     diagonal_blocks fill = {false, false};
     std::fill_n( &vehicle_obscured_cache[0][0], map_dimensions, fill );
+    std::fill_n( &light_obscured_snapshot[0][0], map_dimensions, fill );
     std::fill_n( &vehicle_obstructed_cache[0][0], map_dimensions, fill );
     std::fill_n( &seen_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &camera_cache[0][0], map_dimensions, 0.0f );
@@ -9184,6 +9312,8 @@ level_cache::level_cache()
 pathfinding_cache::pathfinding_cache()
 {
     dirty = true;
+    dirty_submaps.set();
+    std::uninitialized_fill_n( &special[0][0], MAPSIZE_X * MAPSIZE_Y, PF_NORMAL );
 }
 
 
@@ -9196,7 +9326,24 @@ pathfinding_cache &map::get_pathfinding_cache( int zlev ) const
 void map::set_pathfinding_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
-        get_pathfinding_cache( zlev ).dirty = true;
+        pathfinding_cache &cache = get_pathfinding_cache( zlev );
+        cache.dirty = true;
+        cache.dirty_submaps.set();
+        if( g != nullptr && this == &get_map() ) {
+            Pathfinding::invalidate_z_level( zlev );
+        }
+    }
+}
+
+void map::set_pathfinding_cache_dirty( const tripoint &p )
+{
+    if( inbounds( p ) ) {
+        pathfinding_cache &cache = get_pathfinding_cache( p.z );
+        cache.dirty = true;
+        cache.dirty_submaps.set( static_cast<size_t>( p.x / SEEX + ( p.y / SEEY ) * MAPSIZE ) );
+        if( g != nullptr && this == &get_map() ) {
+            Pathfinding::invalidate_tile( p );
+        }
     }
 }
 
@@ -9224,6 +9371,7 @@ void map::invalidate_map_cache( const int zlev )
         level_cache &ch = get_cache( zlev );
         ch.floor_cache_dirty = true;
         ch.transparency_cache_dirty.set();
+        ch.scent_transfer_dirty.set();
         ch.seen_cache_dirty = true;
         ch.outside_cache_dirty = true;
         ch.suspension_cache_dirty = true;
@@ -9259,10 +9407,13 @@ void map::update_pathfinding_cache( int zlev ) const
         return;
     }
 
-    std::uninitialized_fill_n( &cache.special[0][0], MAPSIZE_X * MAPSIZE_Y, PF_NORMAL );
-
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            const size_t sm_index = static_cast<size_t>( smx + smy * MAPSIZE );
+            if( !cache.dirty_submaps[sm_index] ) {
+                continue;
+            }
+
             const auto cur_submap = get_submap_at_grid( { smx, smy, zlev } );
             if( !cur_submap ) {
                 return;
@@ -9325,6 +9476,11 @@ void map::update_pathfinding_cache( int zlev ) const
                     cache.special[p.x][p.y] = cur_value;
                 }
             }
+
+            cache.dirty_submaps.reset( sm_index );
+            for( auto &entry : cache.regions ) {
+                entry.second.dirty_regions.set( sm_index );
+            }
         }
     }
 
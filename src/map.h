@@ -9,6 +9,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <tuple>
@@ -294,12 +295,38 @@ struct diagonal_blocks {
     bool ne;
 };
 
+// Light rays cast by one buffered light source, kept so that it can be reapplied to the
+// lightmap on later turns without recasting, as long as nothing it depends on has changed.
+struct light_source_contribution {
+    float luminance = 0.0f;
+    // Bitmask of the cardinal directions rays were cast into (see map::apply_light_source)
+    int directions = 0;
+    // Value of level_cache::light_input_clock when the rays were cast
+    uint64_t cast_at = 0;
+    // Half-size of the square around the source whose transparency the rays depend on
+    int radius = 0;
+    // Every tile the rays lit, with the light they left on it
+    std::vector<std::pair<point, four_quadrants>> lit;
+};
+
+// A gas spreading out of a tile, collected while fields are processed with
+// parallel_field_spread and applied once the whole z-level is done (see map::process_fields)
+struct gas_spread {
+    tripoint p;
+    field_type_id type;
+    int windpower = 0;
+    bool sheltered = false;
+    // Tile the gas moves to, picked from the state of the map before any of the spreads
+    std::optional<tripoint> dst;
+};
+
 struct level_cache {
     // Zeros all relevant values
     level_cache();
     level_cache( const level_cache &other ) = default;
 
     std::bitset<MAPSIZE *MAPSIZE> transparency_cache_dirty;
+    std::bitset<MAPSIZE *MAPSIZE> scent_transfer_dirty;
     bool outside_cache_dirty = false;
     bool floor_cache_dirty = false;
     bool seen_cache_dirty = false;
@@ -313,6 +340,16 @@ struct level_cache {
     // This is only valid for the duration of generate_lightmap
     float light_source_buffer[MAPSIZE_X][MAPSIZE_Y];
 
+    // Light cast by each buffered light source on the last generate_lightmap, by position
+    std::map<point, light_source_contribution> light_source_contributions;
+    // Bumped for a submap whenever the light casting inputs (transparency_cache and
+    // vehicle_obscured_cache) within it change, stamped from light_input_clock
+    std::array<uint64_t, MAPSIZE *MAPSIZE> light_input_version;
+    uint64_t light_input_clock = 0;
+    // Light casting inputs as of the last generate_lightmap, to detect changes
+    float light_transparency_snapshot[MAPSIZE_X][MAPSIZE_Y];
+    diagonal_blocks light_obscured_snapshot[MAPSIZE_X][MAPSIZE_Y];
+
     // if false, means tile is under the roof ("inside"), true means tile is "outside"
     // "inside" tiles are protected from sun, rain, etc. (see "INDOORS" flag)
     bool outside_cache[MAPSIZE_X][MAPSIZE_Y];
@@ -327,6 +364,10 @@ struct level_cache {
     // units: "transparency" (see LIGHT_TRANSPARENCY_OPEN_AIR)
     float transparency_cache[MAPSIZE_X][MAPSIZE_Y];
 
+    // stores how well scent spreads through terrain and furniture of the tiles,
+    // 0 for blocking, 1 for reducing and 5 for normal (see map::scent_blockers)
+    char scent_transfer_cache[MAPSIZE_X][MAPSIZE_Y];
+
     // true when light entering a tile diagonally is blocked by the walls of a turned vehicle. The direction is the direction that the light must be travelling.
     // check the nw value of x+1, y+1 to find the se value of a tile and the ne of x-1, y+1 for sw
     diagonal_blocks vehicle_obscured_cache[MAPSIZE_X][MAPSIZE_Y];
@@ -346,6 +387,14 @@ struct level_cache {
     lit_level visibility_cache[MAPSIZE_X][MAPSIZE_Y];
     std::bitset<MAPSIZE_X *MAPSIZE_Y> map_memory_seen_cache;
     std::bitset<MAPSIZE *MAPSIZE> field_cache;
+    // Tiles of each submap that may hold fields, in submap coordinates, so that field processing
+    // doesn't have to scan whole submaps. Complete only for submaps not in field_tiles_unlisted,
+    // which get scanned when their fields are next processed.
+    std::array<std::vector<point>, MAPSIZE *MAPSIZE> field_tiles;
+    std::bitset<MAPSIZE_X *MAPSIZE_Y> field_tile_listed;
+    std::bitset<MAPSIZE *MAPSIZE> field_tiles_unlisted;
+    // Gas spreads waiting to be applied, in the order the tiles were processed
+    std::vector<gas_spread> gas_spreads;
 
     bool veh_in_active_range;
     bool veh_exists_at[MAPSIZE_X][MAPSIZE_Y];
@@ -420,6 +469,12 @@ class map
         void set_suspension_cache_dirty( const int zlev );
 
         void set_pathfinding_cache_dirty( int zlev );
+        // Only the submap containing p
+        void set_pathfinding_cache_dirty( const tripoint &p );
+
+        void set_scent_cache_dirty( int zlev );
+        // Only the submap containing p
+        void set_scent_cache_dirty( const tripoint &p );
         /*@}*/
 
         void set_memory_seen_cache_dirty( const tripoint &p );
@@ -535,8 +590,16 @@ class map
         void spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
                          const time_duration &outdoor_age_speedup, scent_block &sblk );
         void create_hot_air( const tripoint &p, int intensity );
-        bool gas_can_spread_to( field_entry &cur, const tripoint &src, const tripoint &dst );
+        bool gas_can_spread_to( const field_entry &cur, const tripoint &src, const tripoint &dst );
         void gas_spread_to( field_entry &cur, maptile &dst, const tripoint &p );
+        /**
+         * Picks the tile the gas @p cur moves to like @ref spread_gas does, with random numbers
+         * drawn from @p seed. Only reads the map, so it can run on any thread.
+         */
+        std::optional<tripoint> plan_gas_spread( const field_entry &cur, const gas_spread &spread,
+                int winddirection, unsigned int seed );
+        /** Picks and applies the gas spreads collected while processing the fields of @p zlev. */
+        void apply_gas_spreads( int zlev );
         int burn_body_part( player &u, field_entry &cur, body_part bp, int scale );
     public:
 
@@ -702,6 +765,23 @@ class map
         std::vector<tripoint> route( const tripoint &f, const tripoint &t,
                                      const pathfinding_settings &settings,
         const std::set<tripoint> &pre_closed = {{ }} ) const;
+    private:
+        // The tile by tile search of route(), kept to the submaps in corridor if it's not null
+        std::vector<tripoint> route_tiles( const tripoint &f, const tripoint &t,
+                                           const pathfinding_settings &settings,
+                                           const std::set<tripoint> &pre_closed,
+                                           const std::bitset<MAPSIZE *MAPSIZE> *corridor ) const;
+        /**
+         * Plans a route on a single z-level over the regions of the submaps and marks
+         * the submaps around it in corridor.
+         * @return false if t can't be reached. corridor is left empty if the regions can't tell.
+         */
+        bool plan_route_corridor( const tripoint &f, const tripoint &t,
+                                  const pathfinding_settings &settings,
+                                  std::bitset<MAPSIZE *MAPSIZE> &corridor ) const;
+        // Whether route_tiles could ever step on p, erring on the side of true
+        bool route_may_enter( const tripoint &p, const pathfinding_settings &settings ) const;
+    public:
 
         // Vehicles: Common to 2D and 3D
         VehicleList get_vehicles();
@@ -1381,6 +1461,11 @@ class map
         // See fields.cpp
         void process_fields();
         void process_fields_in_submap( submap *current_submap, const tripoint &submap_pos );
+        /** Adds a tile to the field processing list, unless it or its submap is already on it. */
+        void list_field_tile( const tripoint &p );
+        /** Forgets the field tiles of a submap (or of all submaps) until they are scanned again. */
+        void set_field_tiles_unlisted( const tripoint &grid );
+        void set_field_tiles_unlisted( int zlev );
         /**
          * Apply field effects to the creature when it's on a square with fields.
          */
@@ -1492,7 +1577,8 @@ class map
         // Scent propagation helpers
         /**
          * Build the map of scent-resistant tiles.
-         * Should be way faster than if done in `game.cpp` using public map functions.
+         * Terrain and furniture are cached per submap until they change, vehicles are always
+         * looked up.
          */
         void scent_blockers( std::array<std::array<char, MAPSIZE_X>, MAPSIZE_Y> &scent_transfer,
                              point min, point max );
@@ -1788,7 +1874,13 @@ class map
 
         // Builds a transparency cache and returns true if the cache was invalidated.
         // Used to determine if seen cache should be rebuilt.
-        bool build_transparency_cache( int zlev );
+        // sight_penalty is that of the current weather, read by the caller because this may run
+        // on a worker thread.
+        bool build_transparency_cache( int zlev, float sight_penalty );
+        // Matches the shadowcasting lookup table for air to the sight penalty of the current weather.
+        // It's shared by all z-levels, so this has to happen before building their transparency
+        // caches in parallel.
+        void update_weather_transparency_lookup( float sight_penalty );
         bool build_vision_transparency_cache( const Character &player );
         // fills lm with sunlight. pzlev is current player's zlevel
         void build_sunlight_cache( int pzlev );
@@ -1913,6 +2005,11 @@ class map
         // ...this, which will apply the light after at the end of generate_lightmap, and prevent redundant
         // light rays from causing massive slowdowns, if there's a huge amount of light.
         void add_light_source( const tripoint &p, float luminance );
+        // Same as apply_light_source, but reuses the rays cast for this source on an earlier
+        // turn if its luminance and surroundings haven't changed since. Only for light_source_buffer.
+        void apply_buffered_light_source( const tripoint &p, float luminance );
+        // Mark the submaps whose light casting inputs changed since the last call
+        void update_light_input_versions( int zlev );
         // Handle just cardinal directions and 45 deg angles.
         void apply_directional_light( const tripoint &p, int direction, float luminance );
         void apply_light_arc( const tripoint &p, units::angle, float luminance,
@@ -1994,6 +2091,11 @@ class map
          * Set of submaps that contain active items in absolute coordinates.
          */
         std::set<tripoint> submaps_with_active_items;
+        /**
+         * Number of active items the last call to @ref process_items woke up, on the map and in
+         * vehicles. Also plotted in the profiler.
+         */
+        int active_items_processed = 0;
 
         /**
          * Cache of coordinate pairs recently checked for visibility.
@@ -2037,6 +2139,10 @@ class map
         const std::set<tripoint> &get_submaps_with_active_items() const {
             return submaps_with_active_items;
         }
+        // Number of active items processed by the last call to process_items
+        int get_active_items_processed() const {
+            return active_items_processed;
+        }
         // Clips the area to map bounds
         tripoint_range<tripoint> points_in_rectangle(
             const tripoint &from, const tripoint &to ) const;
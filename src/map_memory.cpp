@@ -1,5 +1,8 @@
 #include "map_memory.h"
 
+#include <deque>
+#include <unordered_map>
+
 #include "coordinate_conversions.h"
 #include "cuboid_rectangle.h"
 #include "debug.h"
@@ -30,8 +33,80 @@ struct reg_coord_pair {
     }
 };
 
+namespace
+{
+
+struct tile_id_table {
+    // A deque, so adding a name doesn't move the ones handed out by memorized_tile_ids::name
+    std::deque<std::string> names{ std::string() };
+    std::unordered_map<std::string, uint32_t> ids{ { std::string(), 0 } };
+};
+
+tile_id_table &tile_ids()
+{
+    static tile_id_table table;
+    return table;
+}
+
+} // namespace
+
+namespace memorized_tile_ids
+{
+
+uint32_t intern( const std::string &name )
+{
+    tile_id_table &table = tile_ids();
+    const auto emplaced = table.ids.emplace( name, static_cast<uint32_t>( table.names.size() ) );
+    if( emplaced.second ) {
+        table.names.push_back( name );
+    }
+    return emplaced.first->second;
+}
+
+const std::string &name( uint32_t id )
+{
+    return tile_ids().names[id];
+}
+
+size_t size()
+{
+    return tile_ids().names.size();
+}
+
+size_t memory_usage()
+{
+    const tile_id_table &table = tile_ids();
+    size_t usage = table.names.size() * sizeof( std::string );
+    for( const std::string &name : table.names ) {
+        // Both the vector and the map hold a copy
+        usage += 2 * name.capacity() + sizeof( std::pair<const std::string, uint32_t> ) +
+                 2 * sizeof( void * );
+    }
+    return usage;
+}
+
+} // namespace memorized_tile_ids
+
 mm_submap::mm_submap() = default;
 
+void mm_submap::set_tile( point p, const std::string &tile, int subtile, int rotation )
+{
+    mm_packed_tile packed = packed_tile( p );
+    // Most tiles are memorized again as they were, which doesn't need a lookup
+    if( packed.name() != tile ) {
+        packed.id = memorized_tile_ids::intern( tile );
+    }
+    packed.subtile = static_cast<int16_t>( subtile );
+    packed.rotation = static_cast<int16_t>( rotation );
+    set_packed_tile( p, packed );
+}
+
+size_t mm_submap::memory_usage() const
+{
+    return sizeof( mm_submap ) + tiles.capacity() * sizeof( mm_packed_tile ) +
+           symbols.capacity() * sizeof( int );
+}
+
 mm_region::mm_region() : submaps {{ nullptr }} {}
 
 bool mm_region::is_empty() const
@@ -56,11 +131,11 @@ map_memory::map_memory()
     clear_cache();
 }
 
-const memorized_terrain_tile &map_memory::get_tile( const tripoint &pos )
+mm_packed_tile map_memory::get_tile( const tripoint &pos )
 {
     coord_pair p( pos );
     const mm_submap &sm = get_submap( p.sm );
-    return sm.tile( p.loc );
+    return sm.packed_tile( p.loc );
 }
 
 bool map_memory::has_memory_for_autodrive( const tripoint &pos )
@@ -74,7 +149,7 @@ bool map_memory::has_memory_for_autodrive( const tripoint &pos )
     //       Oh, and we don't want to use get_tile() and get_symbol() to avoid looking up the mm_submap twice.
     coord_pair p( pos );
     shared_ptr_fast<mm_submap> sm = fetch_submap( p.sm );
-    return sm->tile( p.loc ) != mm_submap::default_tile ||
+    return sm->packed_tile( p.loc ) != mm_packed_tile() ||
            sm->symbol( p.loc ) != mm_submap::default_symbol;
 }
 
@@ -83,7 +158,7 @@ void map_memory::memorize_tile( const tripoint &pos, const std::string &ter,
 {
     coord_pair p( pos );
     mm_submap &sm = get_submap( p.sm );
-    sm.set_tile( p.loc, memorized_terrain_tile{ ter, subtile, rotation } );
+    sm.set_tile( p.loc, ter, subtile, rotation );
 }
 
 int map_memory::get_symbol( const tripoint &pos )
@@ -105,7 +180,7 @@ void map_memory::clear_memorized_tile( const tripoint &pos )
     coord_pair p( pos );
     mm_submap &sm = get_submap( p.sm );
     sm.set_symbol( p.loc, mm_submap::default_symbol );
-    sm.set_tile( p.loc, mm_submap::default_tile );
+    sm.set_packed_tile( p.loc, mm_packed_tile() );
 }
 
 bool map_memory::prepare_region( const tripoint &p1, const tripoint &p2 )
@@ -203,12 +278,11 @@ static void temp_remove_open_air( const shared_ptr_fast<mm_submap> &sm )
     if( sm->is_empty() ) {
         return;
     }
+    const uint32_t open_air = memorized_tile_ids::intern( "t_open_air" );
     for( int x = 0; x < SEEX; x++ ) {
         for( int y = 0; y < SEEY; y++ ) {
-            const memorized_terrain_tile &t = sm->tile( {x, y} );
-
-            if( !t.tile.empty() && t.tile == "t_open_air" ) {
-                sm->set_tile( {x, y}, mm_submap::default_tile );
+            if( sm->packed_tile( {x, y} ).id == open_air ) {
+                sm->set_packed_tile( {x, y}, mm_packed_tile() );
             }
         }
     }
@@ -357,6 +431,15 @@ bool map_memory::save( const tripoint &pos )
     return result;
 }
 
+size_t map_memory::memory_usage() const
+{
+    size_t usage = 0;
+    for( const auto &it : submaps ) {
+        usage += it.second->memory_usage();
+    }
+    return usage;
+}
+
 void map_memory::clear_cache()
 {
     cached.clear();
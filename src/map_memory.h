@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "game_constants.h"
 #include "memory_fast.h"
@@ -24,6 +27,39 @@ struct memorized_terrain_tile {
     }
 };
 
+/**
+ * Interned names of the tiles remembered in map memory.
+ * Ids are only valid while the game runs, saves store the names.
+ */
+namespace memorized_tile_ids
+{
+/** Id of the tile named @p name, added to the table if not there yet. */
+uint32_t intern( const std::string &name );
+/** Name of the tile with @p id. Names never move or go away, so the reference stays valid. */
+const std::string &name( uint32_t id );
+/** Number of names in the table, including the empty name with id 0. */
+size_t size();
+/** Approximate number of bytes used by the table. */
+size_t memory_usage();
+} // namespace memorized_tile_ids
+
+/**
+ * A memorized tile as stored in @ref mm_submap, with its name interned.
+ * Cheap to copy, @ref name reads the name from the table without copying it.
+ */
+struct mm_packed_tile {
+    uint32_t id = 0;
+    int16_t subtile = 0;
+    // In degrees for vehicle parts, so it needs more than a byte
+    int16_t rotation = 0;
+
+    const std::string &name() const {
+        return memorized_tile_ids::name( id );
+    }
+
+    bool operator==( const mm_packed_tile &rhs ) const = default;
+};
+
 /** Represent a submap-sized chunk of tile memory. */
 struct mm_submap {
     public:
@@ -38,19 +74,25 @@ struct mm_submap {
             return tiles.empty() && symbols.empty();
         }
 
-        const memorized_terrain_tile &tile( point p ) const {
+        mm_packed_tile packed_tile( point p ) const {
             if( tiles.empty() ) {
-                return default_tile;
+                return mm_packed_tile();
             } else {
                 return tiles[p.y * SEEX + p.x];
             }
         }
 
+        void set_tile( point p, const std::string &tile, int subtile, int rotation );
+
         void set_tile( point p, const memorized_terrain_tile &value ) {
+            set_tile( p, value.tile, value.subtile, value.rotation );
+        }
+
+        void set_packed_tile( point p, const mm_packed_tile &value ) {
             if( tiles.empty() ) {
                 // call 'reserve' first to force allocation of exact size
                 tiles.reserve( SEEX * SEEY );
-                tiles.resize( SEEX * SEEY, default_tile );
+                tiles.resize( SEEX * SEEY );
             }
             tiles[p.y * SEEX + p.x] = value;
         }
@@ -72,11 +114,14 @@ struct mm_submap {
             symbols[p.y * SEEX + p.x] = value;
         }
 
+        /** Approximate number of bytes used by this submap. */
+        size_t memory_usage() const;
+
         void serialize( JsonOut &jsout ) const;
         void deserialize( JsonIn &jsin );
 
     private:
-        std::vector<memorized_terrain_tile> tiles; // holds either 0 or SEEX*SEEY elements
+        std::vector<mm_packed_tile> tiles; // holds either 0 or SEEX*SEEY elements
         std::vector<int> symbols; // holds either 0 or SEEX*SEEY elements
         bool valid = true;
 };
@@ -149,7 +194,7 @@ class map_memory
          * Returns memorized tile.
          * @param pos tile position, in global ms coords.
          */
-        const memorized_terrain_tile &get_tile( const tripoint &pos );
+        mm_packed_tile get_tile( const tripoint &pos );
 
         /**
          * For autodrive use only.
@@ -176,6 +221,14 @@ class map_memory
          */
         void clear_memorized_tile( const tripoint &pos );
 
+        /** Number of submaps held in memory. */
+        size_t loaded_submaps() const {
+            return submaps.size();
+        }
+
+        /** Approximate number of bytes used by the submaps held in memory. */
+        size_t memory_usage() const;
+
     private:
         std::map<tripoint, shared_ptr_fast<mm_submap>> submaps;
 
@@ -0,0 +1,110 @@
+#include "map_quad_prefetcher.h"
+
+#include <utility>
+
+map_quad_prefetcher::map_quad_prefetcher( fetch_fn fetch ) : fetch( std::move( fetch ) ) {}
+
+map_quad_prefetcher::~map_quad_prefetcher()
+{
+    {
+        std::lock_guard<std::mutex> lk( mutex );
+        stopping = true;
+    }
+    queue_cv.notify_all();
+    if( worker.joinable() ) {
+        worker.join();
+    }
+}
+
+void map_quad_prefetcher::request( const std::vector<std::string> &paths )
+{
+    {
+        std::lock_guard<std::mutex> lk( mutex );
+        queue.clear();
+        for( const std::string &path : paths ) {
+            if( !ready.contains( path ) && path != in_progress ) {
+                queue.push_back( path );
+            }
+        }
+        if( queue.empty() ) {
+            return;
+        }
+        if( !worker.joinable() ) {
+            worker = std::thread( &map_quad_prefetcher::worker_loop, this );
+        }
+    }
+    queue_cv.notify_one();
+}
+
+bool map_quad_prefetcher::take( const std::string &path, bool &found, std::string &data )
+{
+    std::unique_lock<std::mutex> lk( mutex );
+    done_cv.wait( lk, [&] {
+        return in_progress != path;
+    } );
+    const auto iter = ready.find( path );
+    if( iter == ready.end() ) {
+        return false;
+    }
+    found = iter->second.has_value();
+    if( found ) {
+        data = std::move( *iter->second );
+    }
+    ready.erase( iter );
+    return true;
+}
+
+void map_quad_prefetcher::invalidate( const std::string &path )
+{
+    std::lock_guard<std::mutex> lk( mutex );
+    ready.erase( path );
+    std::erase( queue, path );
+    if( in_progress == path ) {
+        discard_in_progress = true;
+    }
+}
+
+void map_quad_prefetcher::wait_idle()
+{
+    std::unique_lock<std::mutex> lk( mutex );
+    done_cv.wait( lk, [this] {
+        return queue.empty() && in_progress.empty();
+    } );
+}
+
+void map_quad_prefetcher::worker_loop()
+{
+    while( true ) {
+        std::unique_lock<std::mutex> lk( mutex );
+        queue_cv.wait( lk, [this] {
+            return stopping || !queue.empty();
+        } );
+        if( stopping ) {
+            break;
+        }
+        in_progress = std::move( queue.front() );
+        queue.pop_front();
+        discard_in_progress = false;
+        lk.unlock();
+
+        std::optional<std::string> data;
+        bool ok = true;
+        try {
+            data = fetch( in_progress );
+        } catch( ... ) {
+            // Leave it to the main thread to read it again and report the problem.
+            ok = false;
+        }
+
+        lk.lock();
+        if( ok && !discard_in_progress ) {
+            if( ready.size() >= max_ready ) {
+                ready.clear();
+            }
+            ready.emplace( in_progress, std::move( data ) );
+        }
+        in_progress.clear();
+        lk.unlock();
+        done_cv.notify_all();
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Reads map quads the player is heading towards on a background thread, so the
+ * main thread finds them already decompressed when the map shifts onto them.
+ * Only raw bytes are prefetched; parsing into submaps still happens on the main
+ * thread.
+ */
+class map_quad_prefetcher
+{
+    public:
+        /**
+         * Reads the quad at a path, called on the worker thread only.
+         * Returns nullopt if the quad doesn't exist, and throws if it can't be read.
+         */
+        using fetch_fn = std::function<std::optional<std::string>( const std::string &path )>;
+
+        explicit map_quad_prefetcher( fetch_fn fetch );
+        ~map_quad_prefetcher();
+
+        map_quad_prefetcher( const map_quad_prefetcher & ) = delete;
+        map_quad_prefetcher &operator=( const map_quad_prefetcher & ) = delete;
+
+        /**
+         * Replace the quads still waiting to be read with @p paths. Quads that are
+         * no longer requested are never read, the one being read right now is kept.
+         */
+        void request( const std::vector<std::string> &paths );
+
+        /**
+         * Hand over the prefetched contents of @p path, waiting if it is being read right now.
+         * @return false if the quad wasn't prefetched, otherwise @p found tells whether it
+         * exists at all.
+         */
+        bool take( const std::string &path, bool &found, std::string &data );
+
+        /** Forget anything read for @p path, which is about to be overwritten. */
+        void invalidate( const std::string &path );
+
+        /** Wait until every requested quad has been read. */
+        void wait_idle();
+
+    private:
+        void worker_loop();
+
+        /** Unclaimed quads kept around; the whole lot is dropped when this is exceeded. */
+        static constexpr size_t max_ready = 512;
+
+        fetch_fn fetch;
+        std::deque<std::string> queue;
+        /** Prefetched quads by path, holding nullopt for ones that don't exist */
+        std::map<std::string, std::optional<std::string>> ready;
+        std::string in_progress;
+        bool discard_in_progress = false;
+        bool stopping = false;
+        std::mutex mutex;
+        std::condition_variable queue_cv;
+        std::condition_variable done_cv;
+        std::thread worker;
+};
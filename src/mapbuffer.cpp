@@ -3,11 +3,13 @@
 #include <algorithm>
 #include <exception>
 #include <functional>
+#include <iterator>
 #include <set>
 #include <sstream>
 #include <utility>
 #include <vector>
 
+#include "binary_io.h"
 #include "cata_utility.h"
 #include "coordinate_conversions.h"
 #include "debug.h"
@@ -18,6 +20,7 @@
 #include "game_constants.h"
 #include "json.h"
 #include "map.h"
+#include "options.h"
 #include "output.h"
 #include "popup.h"
 #include "string_formatter.h"
@@ -28,6 +31,14 @@
 
 mapbuffer MAPBUFFER;
 
+/**
+ * Binary map quads start with these bytes, which can't begin a JSON document.
+ * The version that follows is bumped whenever the layout written by
+ * submap::store_binary changes.
+ */
+static constexpr char binary_quad_magic[4] = { 'C', 'B', 'M', 'Q' };
+static constexpr uint64_t binary_quad_version = 1;
+
 mapbuffer::mapbuffer() = default;
 mapbuffer::~mapbuffer() = default;
 
@@ -84,6 +95,52 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
     return iter->second.get();
 }
 
+void mapbuffer::prefetch_ahead( const tripoint &abs_sub, point direction, int lookahead, int zmin,
+                                int zmax )
+{
+    world *active_world = g->get_active_world();
+    if( active_world == nullptr || direction == point_zero ) {
+        return;
+    }
+
+    // Rows of submaps past the bubble edge along each axis we're moving on.
+    const auto ahead = [&]( int corner, int dir ) {
+        if( dir > 0 ) {
+            return std::make_pair( corner + MAPSIZE, corner + MAPSIZE + lookahead );
+        } else if( dir < 0 ) {
+            return std::make_pair( corner - lookahead, corner );
+        }
+        return std::make_pair( corner, corner + MAPSIZE );
+    };
+    // Moving diagonally, the band along each axis covers the corner too.
+    const auto span = [&]( int corner, int dir ) {
+        return std::make_pair( dir < 0 ? corner - lookahead : corner,
+                               dir > 0 ? corner + MAPSIZE + lookahead : corner + MAPSIZE );
+    };
+
+    std::set<tripoint> quads;
+    const auto add_band = [&]( std::pair<int, int> xs, std::pair<int, int> ys ) {
+        for( int z = zmin; z <= zmax; z++ ) {
+            for( int x = xs.first; x < xs.second; x++ ) {
+                for( int y = ys.first; y < ys.second; y++ ) {
+                    const tripoint sm( x, y, z );
+                    if( !is_submap_loaded( sm ) ) {
+                        quads.insert( sm_to_omt_copy( sm ) );
+                    }
+                }
+            }
+        }
+    };
+    if( direction.x != 0 ) {
+        add_band( ahead( abs_sub.x, direction.x ), span( abs_sub.y, direction.y ) );
+    }
+    if( direction.y != 0 ) {
+        add_band( span( abs_sub.x, direction.x ), ahead( abs_sub.y, direction.y ) );
+    }
+
+    active_world->prefetch_map_quads( std::vector<tripoint>( quads.begin(), quads.end() ) );
+}
+
 void mapbuffer::save( bool delete_after_save )
 {
     int num_saved_submaps = 0;
@@ -136,6 +193,11 @@ void mapbuffer::save( bool delete_after_save )
                    om_addr.y > map_origin.y + HALF_MAPSIZE );
         num_saved_submaps += 4;
     }
+    // Quads are compressed and written in the background during a save; make sure
+    // they made it to disk so any failure is reported from here.
+    if( world *active_world = g != nullptr ? g->get_active_world() : nullptr ) {
+        active_world->flush_pending_writes();
+    }
     for( auto &elem : submaps_to_delete ) {
         remove_submap( elem );
     }
@@ -182,6 +244,36 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
         return;
     }
 
+    if( !get_option<bool>( "SAVE_MAPS_AS_JSON" ) ) {
+        g->get_active_world()->write_map_quad( om_addr, [&]( std::ostream & fout ) {
+            std::vector<std::pair<tripoint, submap *>> to_write;
+            for( auto &submap_addr : submap_addrs ) {
+                const auto it = submaps.find( submap_addr );
+                if( it != submaps.end() && it->second != nullptr ) {
+                    to_write.emplace_back( submap_addr, it->second.get() );
+                }
+            }
+
+            cata::binary_writer out;
+            out.write_bytes( binary_quad_magic, sizeof( binary_quad_magic ) );
+            out.write_varint( binary_quad_version );
+            out.write_varint( to_write.size() );
+            for( const std::pair<tripoint, submap *> &entry : to_write ) {
+                out.write_signed( entry.first.x );
+                out.write_signed( entry.first.y );
+                out.write_signed( entry.first.z );
+                out.write_varint( savegame_version );
+                entry.second->store_binary( out );
+
+                if( delete_after_save ) {
+                    submaps_to_delete.push_back( entry.first );
+                }
+            }
+            fout.write( out.data().data(), out.data().size() );
+        } );
+        return;
+    }
+
     g->get_active_world()->write_map_quad( om_addr, [&]( std::ostream & fout ) {
         JsonOut jsout( fout );
         jsout.start_array();
@@ -227,9 +319,16 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
     // Map the tripoint to the submap quad that stores it.
     const tripoint om_addr = sm_to_omt_copy( p );
 
-    using namespace std::placeholders;
-    if( !g->get_active_world()->read_map_quad( om_addr, std::bind( &mapbuffer::deserialize,
-            this, _1 ) ) ) {
+    const auto reader = [this]( std::istream & fin ) {
+        if( fin.peek() == binary_quad_magic[0] ) {
+            const std::string data( std::istreambuf_iterator<char>( fin ), {} );
+            deserialize_binary( data );
+        } else {
+            JsonIn jsin( fin );
+            deserialize( jsin );
+        }
+    };
+    if( !g->get_active_world()->read_map_quad( om_addr, reader ) ) {
         // If it doesn't exist, trigger generating it.
         return nullptr;
     }
@@ -241,6 +340,35 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
     return submaps[ p ].get();
 }
 
+void mapbuffer::deserialize_binary( std::string_view data )
+{
+    cata::binary_reader in( data );
+    if( !in.read_and_compare( binary_quad_magic, sizeof( binary_quad_magic ) ) ) {
+        throw std::runtime_error( "not a binary map quad" );
+    }
+    const uint64_t format_version = in.read_varint();
+    if( format_version > binary_quad_version ) {
+        throw std::runtime_error( string_format( "map quad format %d is newer than this version of the game",
+                                  format_version ) );
+    }
+
+    for( uint64_t count = in.read_varint(); count > 0; count-- ) {
+        tripoint submap_coordinates;
+        submap_coordinates.x = in.read_signed();
+        submap_coordinates.y = in.read_signed();
+        submap_coordinates.z = in.read_signed();
+        const int version = in.read_varint();
+
+        std::unique_ptr<submap> sm = std::make_unique<submap>( sm_to_ms_copy( submap_coordinates ) );
+        sm->load_binary( in, version, multiply_xy( submap_coordinates, 12 ) );
+
+        if( !add_submap( submap_coordinates, sm ) ) {
+            debugmsg( "submap %d,%d,%d was already loaded", submap_coordinates.x, submap_coordinates.y,
+                      submap_coordinates.z );
+        }
+    }
+}
+
 void mapbuffer::deserialize( JsonIn &jsin )
 {
     jsin.start_array();
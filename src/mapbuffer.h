@@ -4,6 +4,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include "coordinates.h"
 #include "point.h"
@@ -71,12 +72,23 @@ class mapbuffer
             return submaps.contains( p );
         }
 
+        /**
+         * Ask the active world to start reading the quads just outside the reality bubble
+         * in the direction it last moved, so the next shift doesn't stall on the disk.
+         * @param abs_sub Absolute submap position of the bubble's corner after the shift.
+         * @param direction The shift that was just applied, in submaps.
+         * @param lookahead How many rows of submaps beyond the edge to read.
+         */
+        void prefetch_ahead( const tripoint &abs_sub, point direction, int lookahead, int zmin,
+                             int zmax );
+
     private:
         // There's a very good reason this is private,
         // if not handled carefully, this can erase in-use submaps and crash the game.
         void remove_submap( tripoint addr );
         submap *unserialize_submaps( const tripoint &p );
         void deserialize( JsonIn &jsin );
+        void deserialize_binary( std::string_view data );
         void save_quad( const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                         bool delete_after_save );
         submap_map_t submaps;
@@ -333,11 +333,19 @@ float monster::rate_target( Creature &c, float best, bool smart ) const
     return FLT_MAX;
 }
 
+/** The faction @p mon is listed under in @ref Creature_tracker::factions */
+static mfaction_id tracked_faction( const monster &mon )
+{
+    static const mfaction_str_id playerfaction( "player" );
+    return mon.friendly == 0 ? mon.faction : playerfaction.id();
+}
+
 void monster::plan()
 {
     ZoneScoped;
 
-    const auto &factions = g->critter_tracker->factions();
+    const Creature_tracker &tracker = *g->critter_tracker;
+    const auto &factions = tracker.factions();
 
     // Bots are more intelligent than most living stuff
     bool smart_planning = has_flag( MF_PRIORITIZE_TARGETS );
@@ -355,6 +363,8 @@ void monster::plan()
     const int angers_cub_threatened = type->has_anger_trigger( mon_trigger::PLAYER_NEAR_BABY ) ? 8 : 0;
     const int fears_hostile_near = type->has_fear_trigger( mon_trigger::HOSTILE_CLOSE ) ? 5 : 0;
 
+    // rate_target gives up on creatures we can't see, which can't be further away than this
+    const int rating_range = std::max( max_sight_range, 1 );
     bool group_morale = has_flag( MF_GROUP_MORALE ) && morale < type->morale;
     bool swarms = has_flag( MF_SWARMS );
     auto mood = attitude();
@@ -403,13 +413,14 @@ void monster::plan()
             }
         }
     } else if( friendly != 0 && !docile && !waiting ) {
-        for( monster &tmp : g->all_monsters() ) {
-            if( tmp.friendly == 0 ) {
-                float rating = rate_target( tmp, dist, smart_planning );
-                if( rating < dist ) {
-                    target = &tmp;
-                    dist = rating;
-                }
+        const auto is_hostile = []( const monster & mon ) {
+            return mon.friendly == 0;
+        };
+        for( monster *tmp : tracker.monsters_in_radius( pos(), rating_range, is_hostile ) ) {
+            float rating = rate_target( *tmp, dist, smart_planning );
+            if( rating < dist ) {
+                target = tmp;
+                dist = rating;
             }
         }
     }
@@ -469,35 +480,27 @@ void monster::plan()
 
     fleeing = fleeing || ( mood == MATT_FLEE );
     if( friendly == 0 ) {
-        for( const auto &fac : factions ) {
-            auto faction_att = faction.obj().attitude( fac.first );
-            if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
-                continue;
-            }
-
-            for( const weak_ptr_fast<monster> &weak : fac.second ) {
-                const shared_ptr_fast<monster> shared = weak.lock();
-                if( !shared ) {
-                    continue;
-                }
-                monster &mon = *shared;
-                float rating = rate_target( mon, dist, smart_planning );
-                if( rating == dist ) {
-                    ++valid_targets;
-                    if( one_in( valid_targets ) ) {
-                        target = &mon;
-                    }
-                }
-                if( rating < dist ) {
-                    target = &mon;
-                    dist = rating;
-                    valid_targets = 1;
-                }
-                if( rating <= 5 ) {
-                    anger += angers_hostile_near;
-                    morale -= fears_hostile_near;
+        const auto is_hostile = [this]( const monster & mon ) {
+            const auto faction_att = faction.obj().attitude( tracked_faction( mon ) );
+            return faction_att != MFA_NEUTRAL && faction_att != MFA_FRIENDLY;
+        };
+        for( monster *mon : tracker.monsters_in_radius( pos(), rating_range, is_hostile ) ) {
+            float rating = rate_target( *mon, dist, smart_planning );
+            if( rating == dist ) {
+                ++valid_targets;
+                if( one_in( valid_targets ) ) {
+                    target = mon;
                 }
             }
+            if( rating < dist ) {
+                target = mon;
+                dist = rating;
+                valid_targets = 1;
+            }
+            if( rating <= 5 ) {
+                anger += angers_hostile_near;
+                morale -= fears_hostile_near;
+            }
         }
     }
 
@@ -514,12 +517,11 @@ void monster::plan()
     }
     swarms = swarms && target == nullptr; // Only swarm if we have no target
     if( group_morale || swarms ) {
-        for( const weak_ptr_fast<monster> &weak : myfaction_iter->second ) {
-            const shared_ptr_fast<monster> shared = weak.lock();
-            if( !shared ) {
-                continue;
-            }
-            monster &mon = *shared;
+        const auto is_ally = [&actual_faction]( const monster & mon ) {
+            return tracked_faction( mon ) == actual_faction;
+        };
+        for( monster *ally : tracker.monsters_in_radius( pos(), rating_range, is_ally ) ) {
+            monster &mon = *ally;
             float rating = rate_target( mon, dist, smart_planning );
             if( group_morale && rating <= 10 ) {
                 morale += 10 - rating;
@@ -891,6 +893,21 @@ void monster::move()
     tripoint destination = this->pos();
 
     if( !this->is_wandering() ) {
+        if( this->goal == g->u.pos() && !get_option<bool>( "USE_LEGACY_PATHFINDING" ) ) {
+            // Hordes converging on the player share one fully expanded d_map and just step down it
+            auto pair = this->get_pathfinding_pair();
+            const std::optional<tripoint> step = Pathfinding::flow_step( this->pos(), this->goal,
+                                                 pair.first, pair.second );
+            if( step ) {
+                this->path = *step == this->goal ?
+                             std::vector<tripoint> { this->goal } :
+                             std::vector<tripoint> { *step, this->goal };
+                this->repath_requested = false;
+            } else {
+                this->repath_requested = true;
+            }
+        }
+
         if( this->repath_requested ) {
             std::vector<tripoint> maybe_new_path;
 
@@ -2183,6 +2183,11 @@ void options_manager::add_options_debug()
          false
        );
 
+    add( "SAVE_MAPS_AS_JSON", debug, translate_marker( "Save maps as JSON" ),
+         translate_marker( "If true, map data is saved as human-readable JSON instead of the compact binary format.  Useful for inspecting or exporting saves.  Maps saved either way can always be loaded." ),
+         false
+       );
+
     add_empty_line();
 
     add( "MOD_SOURCE", debug, translate_marker( "Display Mod Source" ),
@@ -2280,6 +2285,16 @@ void options_manager::add_options_debug()
 
     get_option( "FOV_3D_Z_RANGE" ).setPrerequisite( "FOV_3D" );
 
+    add( "PARALLEL_MAP_CACHE", debug, translate_marker( "Parallel map cache building" ),
+         translate_marker( "If true, the outside and transparency caches of each z-level are built on several threads at once.  The other map caches are still built one z-level at a time." ),
+         true
+       );
+
+    add( "PARALLEL_FIELD_SPREAD", debug, translate_marker( "Parallel gas spreading" ),
+         translate_marker( "If true, gases pick where to spread on several threads, and all of a z-level's gas moves at once after its fields are processed.  Speeds up large fires and smoke clouds, but gas spreads a little differently than it does otherwise." ),
+         false
+       );
+
     add( "ENABLE_EVENTS", debug, translate_marker( "Event bus system" ),
          translate_marker( "If false, achievements and some Magiclysm functionality won't work, but performance will be better." ),
          true
@@ -2500,6 +2515,12 @@ void options_manager::add_options_world_default()
     "any"
        );
 
+    add( "WORLD_COMPRESSION", world_default, translate_marker( "Map compression" ),
+         translate_marker( "How map data is compressed in the world database.  With a trained dictionary, the first save collects samples of this world's map data, and later saves compress small map chunks much better against them.  Older versions of the game cannot read map data compressed with a dictionary, so a world saved with it can no longer be opened by them." ),
+    { { "zlib", translate_marker( "Zlib" ) }, { "zlib_dict", translate_marker( "Zlib with trained dictionary" ) } },
+    "zlib"
+       );
+
     add( "DISABLE_LIFTING", world_default,
          translate_marker( "Disables lifting requirements for vehicle parts." ),
          translate_marker( "If true, strength checks and/or lifting qualities no longer need to be met in order to change parts." ),
@@ -3475,6 +3496,8 @@ void options_manager::cache_to_globals()
     message_cooldown = ::get_option<int>( "MESSAGE_COOLDOWN" );
     fov_3d = ::get_option<bool>( "FOV_3D" );
     fov_3d_z_range = ::get_option<int>( "FOV_3D_Z_RANGE" );
+    parallel_map_cache = ::get_option<bool>( "PARALLEL_MAP_CACHE" );
+    parallel_field_spread = ::get_option<bool>( "PARALLEL_FIELD_SPREAD" );
     static_z_effect = ::get_option<bool>( "STATICZEFFECT" );
     overmap_transparency = ::get_option<bool>( "OVERMAP_TRANSPARENCY" );
     PICKUP_RANGE = ::get_option<int>( "PICKUP_RANGE" );
@@ -265,6 +265,10 @@ std::string PATH_INFO::user_moddir()
 {
     return user_dir_value + "mods/";
 }
+std::string PATH_INFO::verified_data()
+{
+    return config_dir_value + "verified_data.txt";
+}
 std::string PATH_INFO::user_sound()
 {
     return user_dir_value + "sound/";
@@ -44,6 +44,8 @@ std::string templatedir();
 std::string user_dir();
 std::string user_keybindings();
 std::string user_moddir();
+/** Fingerprints of game data that passed the consistency checks. */
+std::string verified_data();
 std::string worldoptions();
 std::string crash();
 std::string tileset_conf();
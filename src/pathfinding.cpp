@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "game.h"
+#include "hash_utils.h"
 #include "map.h"
 #include "map_iterator.h"
 #include "point.h"
@@ -55,6 +56,32 @@ int PathfindingSettings::z_move_type() const
     result += this->can_climb_stairs ? 1 << 1 : 0;
     return result;
 }
+size_t PathfindingSettings::hash() const
+{
+    size_t seed = 0;
+    cata::hash_combine( seed, this->bash_strength_val );
+    cata::hash_combine( seed, this->bash_strength_quanta );
+    cata::hash_combine( seed, this->move_cost_coeff );
+    cata::hash_combine( seed, this->bash_cost );
+    cata::hash_combine( seed, this->climb_cost );
+    cata::hash_combine( seed, this->trap_cost );
+    cata::hash_combine( seed, this->door_open_cost );
+    cata::hash_combine( seed, this->rough_terrain_cost );
+    cata::hash_combine( seed, this->sharp_terrain_cost );
+    cata::hash_combine( seed, this->mob_presence_penalty );
+    cata::hash_combine( seed, this->can_fly );
+    cata::hash_combine( seed, this->can_climb_stairs );
+    // Order independent, since iteration order of equal unordered_maps may differ
+    size_t extra_g_costs_hash = 0;
+    for( const auto &[p, cost] : this->extra_g_costs ) {
+        size_t entry_hash = 0;
+        cata::hash_combine( entry_hash, p );
+        cata::hash_combine( entry_hash, cost );
+        extra_g_costs_hash += entry_hash;
+    }
+    cata::hash_combine( seed, extra_g_costs_hash );
+    return seed;
+}
 // RouteSettings impls
 constexpr bool RouteSettings::is_relative_search_domain() const
 {
@@ -140,15 +167,19 @@ bool Pathfinding::in_bounds( const point &p )
     // Specialized for pathfinding
     return this->tile_state_at( p ) != State::BOUNDS;
 }
+float Pathfinding::f_limit( const point &start, const RouteSettings &route_settings ) const
+{
+    // Could be NaN if max_f_coeff = INFINITY * 0
+    return route_settings.max_f_coeff * (
+               route_settings.f_limit_based_on_max_dist ?
+               route_settings.max_dist :
+               rl_dist_exact( tripoint( start, this->z ), tripoint( this->dest, this->z ) )
+           );
+}
 bool Pathfinding::is_in_limited_domain(
     const point &start, const point &p, const RouteSettings &route_settings )
 {
-    // Could be NaN if max_f_coeff = INFINITY * 0
-    const float max_f = route_settings.max_f_coeff * (
-                            route_settings.f_limit_based_on_max_dist ?
-                            route_settings.max_dist :
-                            rl_dist_exact( tripoint( start, this->z ), tripoint( this->dest, this->z ) )
-                        );
+    const float max_f = this->f_limit( start, route_settings );
 
     const bool is_in_f_limited_area = is_nan( max_f ) || this->get_f_unbiased( p ) <= max_f;
     const bool is_in_search_radius = route_settings.is_in_search_radius( start, p, this->dest );
@@ -181,8 +212,12 @@ Pathfinding::State &Pathfinding::tile_state_at( const point &p )
     return this->tile_state[p.y + 1][p.x + 1];
 }
 /// Pathfinding: d-map wide changes
-void Pathfinding::produce_d_map( point dest, int z, PathfindingSettings settings )
+void Pathfinding::produce_d_map( point dest, int z, PathfindingSettings settings,
+                                 size_t settings_hash )
 {
+    if( Pathfinding::d_maps.size() >= Pathfinding::max_d_maps ) {
+        Pathfinding::recycle_d_map( 0 );
+    }
     if( Pathfinding::d_maps_store.empty() ) {
         std::unique_ptr<Pathfinding> d_map = std::make_unique<Pathfinding>();
         Pathfinding::d_maps_store.push_back( std::move( d_map ) );
@@ -193,24 +228,82 @@ void Pathfinding::produce_d_map( point dest, int z, PathfindingSettings settings
 
     d_map->dest = dest;
     d_map->z = z;
-    d_map->settings = settings;
+    d_map->settings = std::move( settings );
+    d_map->settings_hash = settings_hash;
+    d_map->abs_sub = get_map().get_abs_sub();
 
     Pathfinding::d_maps.push_back( std::move( d_map ) );
 }
+Pathfinding &Pathfinding::get_d_map( point dest, int z, const PathfindingSettings &settings )
+{
+    const size_t settings_hash = settings.hash();
+    const tripoint abs_sub = get_map().get_abs_sub();
+    auto d_map_it = std::ranges::find_if(
+                        Pathfinding::d_maps,
+    [&dest, &settings, settings_hash, &abs_sub, z]( auto & map ) {
+        return map->settings_hash == settings_hash && map->dest == dest && map->z == z &&
+               map->abs_sub == abs_sub && map->settings == settings;
+    } );
+
+    if( d_map_it == Pathfinding::d_maps.end() ) {
+        Pathfinding::produce_d_map( dest, z, settings, settings_hash );
+    } else {
+        // Most recently used goes last
+        std::rotate( d_map_it, d_map_it + 1, Pathfinding::d_maps.end() );
+    }
+    return *Pathfinding::d_maps.back();
+}
+void Pathfinding::recycle_d_map( size_t index )
+{
+    std::unique_ptr<Pathfinding> map = std::move( Pathfinding::d_maps[index] );
+    Pathfinding::d_maps.erase( Pathfinding::d_maps.begin() + index );
+
+    map->reset_maps();
+    map->reset_tile_state();
+    map->unbiased_frontier.clear();
+    map->forbidden_moves.clear();
+    map->domain = Pathfinding::MapDomain::RELATIVE_DOMAIN;
+    map->is_explored = false;
+    Pathfinding::d_maps_store.push_back( std::move( map ) );
+}
 void Pathfinding::clear_d_maps()
 {
-    for( auto &map : Pathfinding::d_maps ) {
-        map->reset_maps();
-        map->reset_tile_state();
-        map->unbiased_frontier.clear();
-        map->forbidden_moves.clear();
-        map->domain = Pathfinding::MapDomain::RELATIVE_DOMAIN;
-        map->is_explored = false;
-        Pathfinding::d_maps_store.push_back( std::move( map ) );
+    while( !Pathfinding::d_maps.empty() ) {
+        Pathfinding::recycle_d_map( Pathfinding::d_maps.size() - 1 );
     }
-    Pathfinding::d_maps.clear();
     Pathfinding::cached_closest_z_changes.clear();
 }
+void Pathfinding::end_turn()
+{
+    const tripoint abs_sub = get_map().get_abs_sub();
+    for( size_t i = Pathfinding::d_maps.size(); i-- > 0; ) {
+        const Pathfinding &map = *Pathfinding::d_maps[i];
+        // Critters move every turn
+        if( map.abs_sub != abs_sub || map.settings.mob_presence_penalty > 0 ) {
+            Pathfinding::recycle_d_map( i );
+        }
+    }
+    Pathfinding::cached_closest_z_changes.clear();
+}
+void Pathfinding::invalidate_tile( const tripoint &p )
+{
+    for( size_t i = Pathfinding::d_maps.size(); i-- > 0; ) {
+        Pathfinding &map = *Pathfinding::d_maps[i];
+        // Tiles the d_map never reached have no g-value to go stale yet
+        if( map.z == p.z && ( map.tile_state_at( p.xy() ) != State::UNVISITED ||
+                              p.xy() == map.dest ) ) {
+            Pathfinding::recycle_d_map( i );
+        }
+    }
+}
+void Pathfinding::invalidate_z_level( int z )
+{
+    for( size_t i = Pathfinding::d_maps.size(); i-- > 0; ) {
+        if( Pathfinding::d_maps[i]->z == z ) {
+            Pathfinding::recycle_d_map( i );
+        }
+    }
+}
 void Pathfinding::reset_maps()
 {
     this->p_at( this->dest ) = 0.0;
@@ -801,19 +894,7 @@ std::vector<tripoint> Pathfinding::get_route_2d(
         return std::vector<tripoint> { tripoint( from, z ), tripoint( to, z ) };
     }
 
-    auto d_map_it = std::ranges::find_if(
-                        Pathfinding::d_maps,
-    [&to, &path_settings, z]( auto & map ) {
-        return map->dest == to && map->z == z && map->settings == path_settings;
-    } );
-
-    Pathfinding *d_map;
-    if( d_map_it == Pathfinding::d_maps.end() ) {
-        Pathfinding::produce_d_map( to, z, path_settings );
-        d_map = Pathfinding::d_maps.back().get();
-    } else {
-        d_map = d_map_it->get();
-    }
+    Pathfinding *d_map = &Pathfinding::get_d_map( to, z, path_settings );
 
     if( !d_map->is_in_limited_domain( from, from, route_settings ) ) {
         // This should only fail if max f-limit is failed
@@ -891,6 +972,61 @@ std::vector<tripoint> Pathfinding::get_route_2d(
     return result;
 }
 
+std::optional<tripoint> Pathfinding::flow_step( const tripoint &from, const tripoint &to,
+        const PathfindingSettings &path_settings,
+        const RouteSettings &route_settings )
+{
+    if( from == to || from.z != to.z || rl_dist( from, to ) > route_settings.max_dist ) {
+        return std::nullopt;
+    }
+
+    Pathfinding &d_map = Pathfinding::get_d_map( to.xy(), to.z, path_settings );
+    // Unbiased expansion pops tiles in cost order, so stopping at `from` still leaves
+    //   a correct gradient around it. The next critter further out picks up the frontier.
+    RouteSettings unbiased;
+    unbiased.h_coeff = 0.0;
+    const point cur_point = from.xy();
+    if( d_map.expand_2d_up_to( cur_point, unbiased ) != ExpansionOutcome::PATH_FOUND ||
+        d_map.tile_state_at( cur_point ) != State::ACCESSIBLE ) {
+        return std::nullopt;
+    }
+
+    const float cur_cost = d_map.get_f_unbiased( cur_point );
+    // Outside the search radius and cone, `route` doesn't expand tiles over the f-limit.
+    //   Each step goes to a cheaper tile, so the rest of the way stays under it too.
+    if( route_settings.is_relative_search_domain() ) {
+        const float max_f = d_map.f_limit( cur_point, route_settings );
+        if( !is_nan( max_f ) && cur_cost > max_f ) {
+            return std::nullopt;
+        }
+    }
+
+    std::vector<std::pair<float, point>> candidates;
+    for( const point &dir : DIRS_2D ) {
+        const point next_point = cur_point + dir;
+        if( !d_map.in_bounds( next_point ) ||
+            d_map.tile_state_at( next_point ) != State::ACCESSIBLE ||
+            d_map.forbidden_moves.contains( {cur_point, next_point} ) ) {
+            continue;
+        }
+
+        const float cost = d_map.get_f_unbiased( next_point );
+        if( cost < cur_cost ) {
+            candidates.emplace_back( cost, next_point );
+        }
+    }
+
+    if( candidates.empty() ) {
+        return std::nullopt;
+    }
+
+    std::ranges::sort( candidates, []( auto & p1, auto & p2 ) {
+        return p1.first < p2.first;
+    } );
+
+    return tripoint( candidates[route_settings.rank_weighted_rng( candidates.size() )].second, to.z );
+}
+
 std::vector<tripoint> Pathfinding::get_route_3d(
     const tripoint from, const tripoint to,
     const PathfindingSettings path_settings,
@@ -64,6 +64,8 @@ struct PathfindingSettings {
 
     bool operator==( const PathfindingSettings &rhs ) const = default;
     int z_move_type() const;
+    // Hash of all the settings, to tell d_maps apart without comparing `extra_g_costs`
+    size_t hash() const;
 };
 
 // A struct defining various coefficient used when creating/calculating a path from a dijikstra map
@@ -212,10 +214,14 @@ class Pathfinding
             std::optional<ZLevelChange> reach_from_above;
         };
 
+        // How many d_maps we keep in `d_maps` at most
+        static constexpr size_t max_d_maps = 32;
+
         // Global state: allocated dijikstra d_maps. Pull to `d_maps` from here.
         static std::vector<std::unique_ptr<Pathfinding>> d_maps_store;
 
-        // Global state: memoized dijikstra d_maps. Transfer to `d_maps_store` every game turn.
+        // Global state: memoized dijikstra d_maps, least recently used first.
+        // They are kept across turns until a tile they reached changes or the map shifts.
         static std::vector<std::unique_ptr<Pathfinding>> d_maps;
 
         // We store the area covered by last Z-scan (in global coords, top left loaded submap)
@@ -260,6 +266,10 @@ class Pathfinding
         int z;
         // `settings` which were used to spawn this map
         PathfindingSettings settings;
+        // `settings.hash()`
+        size_t settings_hash = 0;
+        // Absolute submap position of the map when this d_map was spawned, local coords are relative to it
+        tripoint abs_sub;
 
         MapDomain domain = MapDomain::RELATIVE_DOMAIN;
 
@@ -283,7 +293,12 @@ class Pathfinding
         static std::vector<ZLevelChange> &get_z_cache( const int z );
         static std::unordered_map<point, ZLevelChangeOpenAirPair> &get_z_cache_open_air( const int z );
 
-        static void produce_d_map( point dest, int z, PathfindingSettings settings );
+        static void produce_d_map( point dest, int z, PathfindingSettings settings,
+                                   size_t settings_hash );
+        // Move `d_maps[index]` back to `d_maps_store`, resetting it
+        static void recycle_d_map( size_t index );
+        // Find the d_map for `dest` on `z` spawned with `settings` or spawn a new one, marking it most recently used
+        static Pathfinding &get_d_map( point dest, int z, const PathfindingSettings &settings );
 
         // Get `p`-value at `p`
         float &p_at( const point &p );
@@ -305,6 +320,8 @@ class Pathfinding
                                      const RouteSettings &route_settings,
                                      std::unordered_set<point> &out );
 
+        // Highest unbiased f-value `route_settings` allows for a route from `start`, may be NaN
+        float f_limit( const point &start, const RouteSettings &route_settings ) const;
         // Test if `p` is in our limited domain defined by `route_settings` relative to `start`
         bool is_in_limited_domain( const point &start, const point &p,
                                    const RouteSettings &route_settings );
@@ -330,9 +347,30 @@ class Pathfinding
                                             const std::optional<PathfindingSettings> path_settings = std::nullopt,
                                             const std::optional<RouteSettings> route_settings = std::nullopt );
 
+        // Flow field: next step from `from` towards `to` down the gradient of the d_map of `to`.
+        // Meant for many critters converging on the same target, since they all share one d_map
+        //   per `path_settings` and each step is a lookup of the adjacent tiles.
+        // The d_map is expanded only as far as the farthest critter that asked so far, so when the
+        //   target moves, the cost is one expansion per `path_settings` out to the horde's reach,
+        //   not one over the whole map.
+        // The f-limit of `route_settings` applies when the search radius and cone limit the
+        //   domain, as in `route`: no step is taken from a tile that costs more than the limit.
+        // Only works on a single Z level, returns `std::nullopt` if no step was found.
+        static std::optional<tripoint> flow_step( const tripoint &from, const tripoint &to,
+                const PathfindingSettings &path_settings,
+                const RouteSettings &route_settings );
+
         // Reset whole pathfinding pretty much
         static void clear_d_maps();
 
+        // Drop d_maps that can't be carried over to the next turn, such as those avoiding critters
+        static void end_turn();
+
+        // Drop d_maps that reached `p` since its cost may have changed
+        static void invalidate_tile( const tripoint &p );
+        // Drop d_maps of the whole `z` level
+        static void invalidate_z_level( int z );
+
         // Reset Z-level information. Should only be done when new Z-level changes could have appeared
         //   such as change in terrain
         static void mark_dirty_z_cache();
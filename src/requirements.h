@@ -214,7 +214,7 @@ constexpr requirement_display_flags operator&( requirement_display_flags l,
 */
 struct requirement_data {
         // temporarily break encapsulation pending migration of legacy parts
-        // @see vpart_info::check
+        // @see vpart_info::finalize
         // TODO: remove once all parts specify installation requirements directly
         friend class vpart_info;
 
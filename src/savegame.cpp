@@ -297,6 +297,9 @@ void scent_map::deserialize( const std::string &data, bool is_type )
                 val = stmp;
             }
         }
+        active_min = point_zero;
+        active_max = point( MAPSIZE_X - 1, MAPSIZE_Y - 1 );
+        fit_active_area();
     }
 }
 
@@ -1271,7 +1274,7 @@ void faction_manager::deserialize( JsonIn &jsin )
 void Creature_tracker::deserialize( JsonIn &jsin )
 {
     monsters_list.clear();
-    monsters_by_location.clear();
+    clear_locations();
     jsin.start_array();
     while( !jsin.end_array() ) {
         // TODO: would be nice if monster had a constructor using JsonIn or similar, so this could be one statement.
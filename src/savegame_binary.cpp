@@ -0,0 +1,169 @@
+#include "submap.h" // IWYU pragma: associated
+
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "binary_io.h"
+#include "calendar.h"
+#include "json.h"
+#include "mapdata.h"
+#include "string_id.h"
+#include "trap.h"
+
+// Layout written by submap::store_binary, after the submap header written by the mapbuffer:
+//
+//   signed    turn_last_touched (turns since turn zero)
+//   signed    temperature
+//   id plane  terrain
+//   id plane  furniture
+//   id plane  traps
+//   varint    number of radiation runs, then ( signed value, varint length ) for each run
+//   string    remaining members as the text of a JSON object, see submap::store_contents
+//
+// An id plane is a varint count of ids followed by the id strings, then a varint count of
+// runs followed by ( varint index into the ids, varint length ) for each run.
+// Planes are walked row by row, like the JSON terrain RLE.
+
+namespace
+{
+
+template<typename Id, typename ToString>
+void write_id_plane( cata::binary_writer &out, const Id( &plane )[SEEX][SEEY], ToString to_string )
+{
+    std::vector<Id> ids;
+    std::vector<std::pair<size_t, int>> runs;
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            const Id &id = plane[i][j];
+            if( !runs.empty() && ids[runs.back().first] == id ) {
+                runs.back().second++;
+                continue;
+            }
+            size_t index = 0;
+            while( index < ids.size() && ids[index] != id ) {
+                index++;
+            }
+            if( index == ids.size() ) {
+                ids.push_back( id );
+            }
+            runs.emplace_back( index, 1 );
+        }
+    }
+
+    out.write_varint( ids.size() );
+    for( const Id &id : ids ) {
+        out.write_string( to_string( id ) );
+    }
+    out.write_varint( runs.size() );
+    for( const std::pair<size_t, int> &run : runs ) {
+        out.write_varint( run.first );
+        out.write_varint( run.second );
+    }
+}
+
+template<typename Id, typename FromString>
+void read_id_plane( cata::binary_reader &in, Id( &plane )[SEEX][SEEY], FromString from_string )
+{
+    std::vector<Id> ids( in.read_varint() );
+    for( Id &id : ids ) {
+        id = from_string( std::string( in.read_string() ) );
+    }
+
+    int cell = 0;
+    for( uint64_t runs = in.read_varint(); runs > 0; runs-- ) {
+        const uint64_t index = in.read_varint();
+        const uint64_t length = in.read_varint();
+        if( index >= ids.size() || length > static_cast<uint64_t>( SEEX * SEEY - cell ) ) {
+            throw std::runtime_error( "submap plane data is corrupt" );
+        }
+        for( uint64_t n = 0; n < length; n++, cell++ ) {
+            plane[cell % SEEX][cell / SEEX] = ids[index];
+        }
+    }
+    if( cell != SEEX * SEEY ) {
+        throw std::runtime_error( "submap plane data is incomplete" );
+    }
+}
+
+} // namespace
+
+void submap::store_binary( cata::binary_writer &out ) const
+{
+    out.write_signed( to_turns<int64_t>( last_touched - calendar::turn_zero ) );
+    out.write_signed( temperature );
+
+    write_id_plane( out, ter, []( const ter_id & id ) {
+        return id.id().str();
+    } );
+    write_id_plane( out, frn, []( const furn_id & id ) {
+        return id.id().str();
+    } );
+    write_id_plane( out, trp, []( const trap_id & id ) {
+        return id.id().str();
+    } );
+
+    std::vector<std::pair<int, int>> rad_runs;
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            if( !rad_runs.empty() && rad_runs.back().first == rad[i][j] ) {
+                rad_runs.back().second++;
+            } else {
+                rad_runs.emplace_back( rad[i][j], 1 );
+            }
+        }
+    }
+    out.write_varint( rad_runs.size() );
+    for( const std::pair<int, int> &run : rad_runs ) {
+        out.write_signed( run.first );
+        out.write_varint( run.second );
+    }
+
+    std::ostringstream contents;
+    JsonOut jsout( contents );
+    jsout.start_object();
+    store_contents( jsout );
+    jsout.end_object();
+    out.write_string( contents.str() );
+}
+
+void submap::load_binary( cata::binary_reader &in, int version, const tripoint &offset )
+{
+    last_touched = calendar::turn_zero + time_duration::from_turns( in.read_signed() );
+    temperature = in.read_signed();
+
+    read_id_plane( in, ter, []( const std::string & id ) {
+        return ter_str_id( id ).id();
+    } );
+    read_id_plane( in, frn, []( const std::string & id ) {
+        return furn_str_id( id ).id();
+    } );
+    read_id_plane( in, trp, []( const std::string & id ) {
+        return trap_str_id( id ).id();
+    } );
+
+    int cell = 0;
+    for( uint64_t runs = in.read_varint(); runs > 0; runs-- ) {
+        const int value = in.read_signed();
+        const uint64_t length = in.read_varint();
+        if( length > static_cast<uint64_t>( SEEX * SEEY - cell ) ) {
+            throw std::runtime_error( "submap radiation data is corrupt" );
+        }
+        for( uint64_t n = 0; n < length; n++, cell++ ) {
+            rad[cell % SEEX][cell / SEEX] = value;
+        }
+    }
+    if( cell != SEEX * SEEY ) {
+        throw std::runtime_error( "submap radiation data is corrupt" );
+    }
+
+    std::istringstream contents( std::string( in.read_string() ) );
+    JsonIn jsin( contents );
+    jsin.start_object();
+    while( !jsin.end_object() ) {
+        const std::string member_name = jsin.get_member_name();
+        load( jsin, member_name, version, offset );
+    }
+}
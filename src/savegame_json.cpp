@@ -3265,93 +3265,133 @@ void player_morale::load( const JsonObject &jsin )
     jsin.read( "morale", points );
 }
 
-struct mm_elem {
-    memorized_terrain_tile tile;
-    int symbol;
-
-    bool operator==( const mm_elem &rhs ) const {
-        return symbol == rhs.symbol && tile == rhs.tile;
-    }
-};
-
 void mm_submap::serialize( JsonOut &jsout ) const
 {
-    jsout.start_array();
+    // Each tile name is written once, and tiles refer to it by its index in "ids".
+    // Tiles are run length encoded in "runs", five numbers per run:
+    // name index, subtile, rotation, symbol and the number of tiles in the run.
+    std::vector<uint32_t> ids;
+    std::vector<int> runs;
 
-    // Uses RLE for compression.
+    const auto index_of = [&ids]( uint32_t id ) {
+        const auto it = std::ranges::find( ids, id );
+        if( it != ids.end() ) {
+            return static_cast<int>( it - ids.begin() );
+        }
+        ids.push_back( id );
+        return static_cast<int>( ids.size() ) - 1;
+    };
 
-    mm_elem last;
-    int num_same = 1;
+    mm_packed_tile last_tile;
+    int last_symbol = default_symbol;
+    int num_same = 0;
 
-    const auto write_seq = [&]() {
-        jsout.start_array();
-        jsout.write( last.tile.tile );
-        jsout.write( last.tile.subtile );
-        jsout.write( last.tile.rotation );
-        jsout.write( last.symbol );
-        if( num_same != 1 ) {
-            jsout.write( num_same );
-        }
-        jsout.end_array();
+    const auto write_run = [&]() {
+        runs.insert( runs.end(), { index_of( last_tile.id ), last_tile.subtile, last_tile.rotation,
+                                   last_symbol, num_same
+                                 } );
     };
 
     for( size_t y = 0; y < SEEY; y++ ) {
         for( size_t x = 0; x < SEEX; x++ ) {
             point p( x, y );
-            const mm_elem elem = { tile( p ), symbol( p ) };
-            if( x == 0 && y == 0 ) {
-                last = elem;
-                continue;
-            }
-            if( last == elem ) {
+            const mm_packed_tile tile = packed_tile( p );
+            const int sym = symbol( p );
+            if( num_same > 0 && tile == last_tile && sym == last_symbol ) {
                 num_same += 1;
                 continue;
             }
-            write_seq();
+            if( num_same > 0 ) {
+                write_run();
+            }
+            last_tile = tile;
+            last_symbol = sym;
             num_same = 1;
-            last = elem;
         }
     }
-    write_seq();
+    write_run();
 
+    jsout.start_object();
+    jsout.member( "ids" );
+    jsout.start_array();
+    for( const uint32_t id : ids ) {
+        jsout.write( memorized_tile_ids::name( id ) );
+    }
     jsout.end_array();
+    jsout.member( "runs", runs );
+    jsout.end_object();
 }
 
 void mm_submap::deserialize( JsonIn &jsin )
 {
-    jsin.start_array();
-
-    // Uses RLE for compression.
+    if( !jsin.test_object() ) {
+        // Older saves hold an array of runs, each an array of
+        // tile name, subtile, rotation, symbol and the run length if it isn't 1.
+        jsin.start_array();
 
-    mm_elem elem;
-    size_t remaining = 0;
+        memorized_terrain_tile tile;
+        int sym = default_symbol;
+        size_t remaining = 0;
 
-    for( size_t y = 0; y < SEEY; y++ ) {
-        for( size_t x = 0; x < SEEX; x++ ) {
-            if( remaining > 0 ) {
-                remaining -= 1;
-            } else {
-                jsin.start_array();
-                elem.tile.tile = jsin.get_string();
-                elem.tile.subtile = jsin.get_int();
-                elem.tile.rotation = jsin.get_int();
-                elem.symbol = jsin.get_int();
-                if( jsin.test_int() ) {
-                    remaining = jsin.get_int() - 1;
+        for( size_t y = 0; y < SEEY; y++ ) {
+            for( size_t x = 0; x < SEEX; x++ ) {
+                if( remaining > 0 ) {
+                    remaining -= 1;
+                } else {
+                    jsin.start_array();
+                    tile.tile = jsin.get_string();
+                    tile.subtile = jsin.get_int();
+                    tile.rotation = jsin.get_int();
+                    sym = jsin.get_int();
+                    if( jsin.test_int() ) {
+                        remaining = jsin.get_int() - 1;
+                    }
+                    jsin.end_array();
+                }
+                point p( x, y );
+                // Try to avoid assigning to save up on memory
+                if( tile != mm_submap::default_tile ) {
+                    set_tile( p, tile );
+                }
+                if( sym != mm_submap::default_symbol ) {
+                    set_symbol( p, sym );
                 }
-                jsin.end_array();
             }
-            point p( x, y );
+        }
+        jsin.end_array();
+        return;
+    }
+
+    JsonObject jo = jsin.get_object();
+    std::vector<uint32_t> ids;
+    for( const std::string name : jo.get_array( "ids" ) ) {
+        ids.push_back( memorized_tile_ids::intern( name ) );
+    }
+    std::vector<int> runs;
+    jo.read( "runs", runs );
+    if( runs.size() % 5 != 0 ) {
+        jo.throw_error( "map memory runs should have five numbers each", "runs" );
+    }
+
+    size_t pos = 0;
+    for( size_t i = 0; i < runs.size(); i += 5 ) {
+        if( runs[i] < 0 || static_cast<size_t>( runs[i] ) >= ids.size() ) {
+            jo.throw_error( "map memory tile refers to an unknown id", "runs" );
+        }
+        const mm_packed_tile tile{ ids[runs[i]], static_cast<int16_t>( runs[i + 1] ),
+                                   static_cast<int16_t>( runs[i + 2] ) };
+        const int sym = runs[i + 3];
+        for( int n = 0; n < runs[i + 4] && pos < SEEX * SEEY; n++, pos++ ) {
+            point p( pos % SEEX, pos / SEEX );
             // Try to avoid assigning to save up on memory
-            if( elem.tile != mm_submap::default_tile ) {
-                set_tile( p, elem.tile );
+            if( tile != mm_packed_tile() ) {
+                set_packed_tile( p, tile );
             }
-            if( elem.symbol != mm_submap::default_symbol ) {
-                set_symbol( p, elem.symbol );
+            if( sym != mm_submap::default_symbol ) {
+                set_symbol( p, sym );
             }
         }
     }
-    jsin.end_array();
 }
 
 void mm_region::serialize( JsonOut &jsout ) const
@@ -3779,20 +3819,6 @@ void submap::store( JsonOut &jsout ) const
     }
     jsout.end_array();
 
-    jsout.member( "items" );
-    jsout.start_array();
-    for( int j = 0; j < SEEY; j++ ) {
-        for( int i = 0; i < SEEX; i++ ) {
-            if( itm[i][j].empty() ) {
-                continue;
-            }
-            jsout.write( i );
-            jsout.write( j );
-            jsout.write( itm[i][j] );
-        }
-    }
-    jsout.end_array();
-
     jsout.member( "traps" );
     jsout.start_array();
     for( int j = 0; j < SEEY; j++ ) {
@@ -3811,6 +3837,25 @@ void submap::store( JsonOut &jsout ) const
     }
     jsout.end_array();
 
+    store_contents( jsout );
+}
+
+void submap::store_contents( JsonOut &jsout ) const
+{
+    jsout.member( "items" );
+    jsout.start_array();
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            if( itm[i][j].empty() ) {
+                continue;
+            }
+            jsout.write( i );
+            jsout.write( j );
+            jsout.write( itm[i][j] );
+        }
+    }
+    jsout.end_array();
+
     jsout.member( "fields" );
     jsout.start_array();
     for( int j = 0; j < SEEY; j++ ) {
@@ -141,7 +141,6 @@ void scenario::check_definitions()
     for( const auto &scen : all_scenarios.get_all() ) {
         scen.check_definition();
     }
-    sc_blacklist.finalize();
 }
 
 static void check_traits( const std::set<trait_id> &traits, const string_id<scenario> &ident )
@@ -302,6 +301,11 @@ void reset_scenarios_blacklist()
     sc_blacklist = scen_blacklist();
 }
 
+void finalize_scenarios_blacklist()
+{
+    sc_blacklist.finalize();
+}
+
 std::vector<profession_id> scenario::permitted_professions() const
 {
     if( !cached_permitted_professions.empty() ) {
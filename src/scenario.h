@@ -127,6 +127,7 @@ struct scen_blacklist {
 };
 
 void reset_scenarios_blacklist();
+void finalize_scenarios_blacklist();
 
 const scenario *get_scenario();
 void set_scenario( const scenario *new_scenario );
@@ -0,0 +1,193 @@
+#include "scent_kernels.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define SCENT_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace scent_kernels
+{
+namespace scalar
+{
+
+void column_sums( const char *transfer, const int *scent, int *sum, int *used, int count )
+{
+    for( int i = 0; i < count; ++i ) {
+        sum[i] = 0;
+        used[i] = 0;
+        for( int j = i - 1; j <= i + 1; ++j ) {
+            sum[i] += transfer[j] * scent[j];
+            used[i] += transfer[j];
+        }
+    }
+}
+
+void add_columns( const int *left, const int *mid, const int *right, int *out, int count )
+{
+    for( int i = 0; i < count; ++i ) {
+        out[i] = left[i] + mid[i] + right[i];
+    }
+}
+
+void diffuse( const char *transfer, const int *scent, const int *total, const int *used,
+              int *out, int count )
+{
+    for( int i = 0; i < count; ++i ) {
+        // Lingering scent
+        int temp_scent = scent[i] * ( 250 - used[i] * transfer[i] );
+        temp_scent -= scent[i] * transfer[i] * ( 45 - used[i] ) / 5;
+        out[i] = ( temp_scent + total[i] * transfer[i] ) / 250;
+    }
+}
+
+} // namespace scalar
+
+#if defined(SCENT_KERNELS_SSE2)
+
+namespace
+{
+
+/** Four transfer values widened to 32 bit lanes. */
+__m128i load_transfer( const char *p )
+{
+    int32_t packed;
+    std::memcpy( &packed, p, sizeof( packed ) );
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bytes = _mm_cvtsi32_si128( packed );
+    return _mm_unpacklo_epi16( _mm_unpacklo_epi8( bytes, zero ), zero );
+}
+
+__m128i load( const int *p )
+{
+    return _mm_loadu_si128( reinterpret_cast<const __m128i *>( p ) );
+}
+
+void store( int *p, __m128i v )
+{
+    _mm_storeu_si128( reinterpret_cast<__m128i *>( p ), v );
+}
+
+/** The low 32 bits of the 64 bit lanes of @p even and @p odd, alternating. */
+__m128i interleave_low_halves( __m128i even, __m128i odd )
+{
+    return _mm_unpacklo_epi32( _mm_shuffle_epi32( even, _MM_SHUFFLE( 0, 0, 2, 0 ) ),
+                               _mm_shuffle_epi32( odd, _MM_SHUFFLE( 0, 0, 2, 0 ) ) );
+}
+
+/** Low 32 bits of the lane-wise products, like the SSE4.1 _mm_mullo_epi32. */
+__m128i mullo( __m128i a, __m128i b )
+{
+    const __m128i even = _mm_mul_epu32( a, b );
+    const __m128i odd = _mm_mul_epu32( _mm_srli_epi64( a, 32 ), _mm_srli_epi64( b, 32 ) );
+    return interleave_low_halves( even, odd );
+}
+
+/** Lane-wise products with transfer values, which can only be 0, 1 or 5. */
+__m128i mul_transfer( __m128i v, __m128i transfer )
+{
+    const __m128i is_one = _mm_cmpeq_epi32( transfer, _mm_set1_epi32( 1 ) );
+    const __m128i is_five = _mm_cmpeq_epi32( transfer, _mm_set1_epi32( 5 ) );
+    const __m128i five_v = _mm_add_epi32( _mm_slli_epi32( v, 2 ), v );
+    return _mm_or_si128( _mm_and_si128( is_one, v ), _mm_and_si128( is_five, five_v ) );
+}
+
+/**
+ * Lane-wise division by a constant truncating toward zero, like integer division.
+ * Divides the magnitudes by multiplying with @p magic, ceil( 2^( 32 + @p shift ) / divisor ),
+ * which is exact for all of them when the rounding error of @p magic times divisor is below
+ * 2^@p shift.
+ */
+__m128i divide( __m128i v, uint32_t magic, int shift )
+{
+    const __m128i sign = _mm_srai_epi32( v, 31 );
+    const __m128i magnitude = _mm_sub_epi32( _mm_xor_si128( v, sign ), sign );
+    const __m128i m = _mm_set1_epi32( static_cast<int32_t>( magic ) );
+    const __m128i even = _mm_srli_epi64( _mm_mul_epu32( magnitude, m ), 32 + shift );
+    const __m128i odd = _mm_srli_epi64( _mm_mul_epu32( _mm_srli_epi64( magnitude, 32 ), m ),
+                                        32 + shift );
+    const __m128i quotient = interleave_low_halves( even, odd );
+    return _mm_sub_epi32( _mm_xor_si128( quotient, sign ), sign );
+}
+
+__m128i divide_by_5( __m128i v )
+{
+    return divide( v, 3435973837u, 2 );
+}
+
+__m128i divide_by_250( __m128i v )
+{
+    return divide( v, 2199023256u, 7 );
+}
+
+} // namespace
+
+void column_sums( const char *transfer, const int *scent, int *sum, int *used, int count )
+{
+    int i = 0;
+    for( ; i + 4 <= count; i += 4 ) {
+        const __m128i t_above = load_transfer( transfer + i - 1 );
+        const __m128i t_here = load_transfer( transfer + i );
+        const __m128i t_below = load_transfer( transfer + i + 1 );
+        __m128i s = mul_transfer( load( scent + i - 1 ), t_above );
+        s = _mm_add_epi32( s, mul_transfer( load( scent + i ), t_here ) );
+        s = _mm_add_epi32( s, mul_transfer( load( scent + i + 1 ), t_below ) );
+        store( sum + i, s );
+        store( used + i, _mm_add_epi32( _mm_add_epi32( t_above, t_here ), t_below ) );
+    }
+    scalar::column_sums( transfer + i, scent + i, sum + i, used + i, count - i );
+}
+
+void add_columns( const int *left, const int *mid, const int *right, int *out, int count )
+{
+    int i = 0;
+    for( ; i + 4 <= count; i += 4 ) {
+        store( out + i, _mm_add_epi32( _mm_add_epi32( load( left + i ), load( mid + i ) ),
+                                       load( right + i ) ) );
+    }
+    scalar::add_columns( left + i, mid + i, right + i, out + i, count - i );
+}
+
+void diffuse( const char *transfer, const int *scent, const int *total, const int *used,
+              int *out, int count )
+{
+    const __m128i v250 = _mm_set1_epi32( 250 );
+    const __m128i v45 = _mm_set1_epi32( 45 );
+    int i = 0;
+    for( ; i + 4 <= count; i += 4 ) {
+        const __m128i t = load_transfer( transfer + i );
+        const __m128i s = load( scent + i );
+        const __m128i u = load( used + i );
+        const __m128i st = mul_transfer( s, t );
+        __m128i temp_scent = _mm_sub_epi32( mullo( s, v250 ), mullo( st, u ) );
+        const __m128i absorbed = mullo( st, _mm_sub_epi32( v45, u ) );
+        temp_scent = _mm_sub_epi32( temp_scent, divide_by_5( absorbed ) );
+        store( out + i, divide_by_250( _mm_add_epi32( temp_scent, mul_transfer( load( total + i ),
+                                       t ) ) ) );
+    }
+    scalar::diffuse( transfer + i, scent + i, total + i, used + i, out + i, count - i );
+}
+
+#else
+
+void column_sums( const char *transfer, const int *scent, int *sum, int *used, int count )
+{
+    scalar::column_sums( transfer, scent, sum, used, count );
+}
+
+void add_columns( const int *left, const int *mid, const int *right, int *out, int count )
+{
+    scalar::add_columns( left, mid, right, out, count );
+}
+
+void diffuse( const char *transfer, const int *scent, const int *total, const int *used,
+              int *out, int count )
+{
+    scalar::diffuse( transfer, scent, total, used, out, count );
+}
+
+#endif
+
+} // namespace scent_kernels
@@ -0,0 +1,41 @@
+#pragma once
+
+/**
+ * Per-column passes of the scent diffusion in @ref scent_map::update.
+ *
+ * The scent map is stored column by column, so they work on a run of consecutive tiles of
+ * one column. Transfer values are 0 for tiles blocking scent, 1 for tiles reducing it and
+ * 5 for all others.
+ * On x86 they are vectorized with SSE2, which every 64 bit x86 build has; elsewhere they
+ * fall back to the plain loops in @ref scent_kernels::scalar, which give identical results.
+ */
+namespace scent_kernels
+{
+
+/**
+ * Sums of each tile and its two neighbours in the column: of their scent weighted by
+ * transfer into @p sum and of their transfer into @p used.
+ * Reads one tile before and one tile after the run.
+ */
+void column_sums( const char *transfer, const int *scent, int *sum, int *used, int count );
+
+/** Sums of the values of three neighbouring columns. */
+void add_columns( const int *left, const int *mid, const int *right, int *out, int count );
+
+/**
+ * New scent of each tile, from its own scent and the sums over the 3x3 block around it
+ * made by @ref column_sums and @ref add_columns.
+ */
+void diffuse( const char *transfer, const int *scent, const int *total, const int *used,
+              int *out, int count );
+
+/** The reference implementations, always available for testing and benchmarking. */
+namespace scalar
+{
+void column_sums( const char *transfer, const int *scent, int *sum, int *used, int count );
+void add_columns( const int *left, const int *mid, const int *right, int *out, int count );
+void diffuse( const char *transfer, const int *scent, const int *total, const int *used,
+              int *out, int count );
+} // namespace scalar
+
+} // namespace scent_kernels
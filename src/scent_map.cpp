@@ -14,6 +14,7 @@
 #include "generic_factory.h"
 #include "map.h"
 #include "output.h"
+#include "scent_kernels.h"
 #include "string_id.h"
 
 static constexpr int SCENT_RADIUS = 40;
@@ -55,16 +56,35 @@ void scent_map::reset()
             val = 0;
         }
     }
+    active_min = point( MAPSIZE_X, MAPSIZE_Y );
+    active_max = point( -1, -1 );
     typescent = scenttype_id();
 }
 
 void scent_map::decay()
 {
-    for( auto &elem : grscent ) {
-        for( auto &val : elem ) {
-            val = std::max( 0, val - 1 );
+    for( int x = active_min.x; x <= active_max.x; ++x ) {
+        for( int y = active_min.y; y <= active_max.y; ++y ) {
+            grscent[x][y] = std::max( 0, grscent[x][y] - 1 );
         }
     }
+    fit_active_area();
+}
+
+void scent_map::fit_active_area()
+{
+    point new_min( MAPSIZE_X, MAPSIZE_Y );
+    point new_max( -1, -1 );
+    for( int x = active_min.x; x <= active_max.x; ++x ) {
+        for( int y = active_min.y; y <= active_max.y; ++y ) {
+            if( grscent[x][y] != 0 ) {
+                new_min = point( std::min( new_min.x, x ), std::min( new_min.y, y ) );
+                new_max = point( std::max( new_max.x, x ), std::max( new_max.y, y ) );
+            }
+        }
+    }
+    active_min = new_min;
+    active_max = new_max;
 }
 
 void scent_map::draw( const catacurses::window &win, const int div, const tripoint &center ) const
@@ -89,6 +109,12 @@ void scent_map::shift( point sm_shift )
         }
     }
     grscent = new_scent;
+    if( active_min.x <= active_max.x && active_min.y <= active_max.y ) {
+        active_min = point( std::max( 0, active_min.x - sm_shift.x ),
+                            std::max( 0, active_min.y - sm_shift.y ) );
+        active_max = point( std::min( MAPSIZE_X - 1, active_max.x - sm_shift.x ),
+                            std::min( MAPSIZE_Y - 1, active_max.y - sm_shift.y ) );
+    }
 }
 
 int scent_map::get( const tripoint &p ) const
@@ -109,6 +135,10 @@ void scent_map::set( const tripoint &p, int value, const scenttype_id &type )
 void scent_map::set_unsafe( const tripoint &p, int value, const scenttype_id &type )
 {
     grscent[p.x][p.y] = value;
+    if( value != 0 ) {
+        active_min = point( std::min( active_min.x, p.x ), std::min( active_min.y, p.y ) );
+        active_max = point( std::max( active_max.x, p.x ), std::max( active_max.y, p.y ) );
+    }
     if( !type.is_empty() ) {
         typescent = type;
     }
@@ -158,88 +188,97 @@ void scent_map::update( const tripoint &center, map &m )
         return;
     }
 
+    // A tile with no scent in it or around it keeps having none, so only the part of the scent
+    // radius within a tile of the active area has to be diffused
+    const point min( std::max( center.x - SCENT_RADIUS, active_min.x - 1 ),
+                     std::max( center.y - SCENT_RADIUS, active_min.y - 1 ) );
+    const point max( std::min( center.x + SCENT_RADIUS, active_max.x + 1 ),
+                     std::min( center.y + SCENT_RADIUS, active_max.y + 1 ) );
+    if( min.x > max.x || min.y > max.y ) {
+        return;
+    }
+    const int width = max.x - min.x + 1;
+    const int height = max.y - min.y + 1;
+
     //the block and reduce scent properties are folded into a single scent_transfer value here
     //block=0 reduce=1 normal=5
     scent_array<char> scent_transfer;
 
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > new_scent;
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > sum_3_scent_y;
-    std::array < std::array < char, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > squares_used_y;
+    // All indexed [x][y], so that the kernels can run down contiguous columns
+    using scent_column = std::array < int, 1 + SCENT_RADIUS * 2 >;
+    std::array < scent_column, 3 + SCENT_RADIUS * 2 > new_scent;
+    std::array < scent_column, 3 + SCENT_RADIUS * 2 > sum_3_scent_y;
+    std::array < scent_column, 3 + SCENT_RADIUS * 2 > squares_used_y;
+    scent_column total;
+    scent_column squares_used;
 
     diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
                 center.z ).vehicle_obstructed_cache;
 
-    // for loop constants
-    const int scentmap_minx = center.x - SCENT_RADIUS;
-    const int scentmap_maxx = center.x + SCENT_RADIUS;
-    const int scentmap_miny = center.y - SCENT_RADIUS;
-    const int scentmap_maxy = center.y + SCENT_RADIUS;
-
-    // The new scent flag searching function. Should be wayyy faster than the old one.
-    m.scent_blockers( scent_transfer, point( scentmap_minx - 1, scentmap_miny - 1 ),
-                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
-
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        sum_3_scent_y[0][x] = 0;
-        squares_used_y[0][x] = 0;
-        sum_3_scent_y[SCENT_RADIUS * 2][x] = 0;
-        squares_used_y[SCENT_RADIUS * 2][x] = 0;
-    }
-
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-
-            point abs( x + scentmap_minx - 1, y + scentmap_miny );
+    m.scent_blockers( scent_transfer, min - point_south_east, max + point_south_east );
 
-            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
-                sum_3_scent_y[y][x] += scent_transfer[abs.x][i] * grscent[abs.x][i];
-                squares_used_y[y][x] += scent_transfer[abs.x][i];
-            }
-        }
+    // remember the sum of the scent val for the 3 neighboring squares that can defuse into
+    for( int x = 0; x < width + 2; ++x ) {
+        const int abs_x = x + min.x - 1;
+        scent_kernels::column_sums( &scent_transfer[abs_x][min.y], &grscent[abs_x][min.y],
+                                    sum_3_scent_y[x].data(), squares_used_y[x].data(), height );
     }
 
-    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-            const point abs( x + scentmap_minx - 1, y + scentmap_miny );
-
-            int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
-            int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
+    for( int x = 1; x < width + 1; ++x ) {
+        const int abs_x = x + min.x - 1;
+        scent_kernels::add_columns( squares_used_y[x - 1].data(), squares_used_y[x].data(),
+                                    squares_used_y[x + 1].data(), squares_used.data(), height );
+        scent_kernels::add_columns( sum_3_scent_y[x - 1].data(), sum_3_scent_y[x].data(),
+                                    sum_3_scent_y[x + 1].data(), total.data(), height );
 
-            //handle vehicle holes
+        //handle vehicle holes
+        for( int y = 0; y < height; ++y ) {
+            const point abs( abs_x, y + min.y );
             if( blocked_cache[abs.x][abs.y].nw && scent_transfer[abs.x + 1][abs.y + 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x + 1][abs.y + 1];
+                squares_used[y] -= 4;
+                total[y] -= 4 * grscent[abs.x + 1][abs.y + 1];
             }
             if( blocked_cache[abs.x][abs.y].ne && scent_transfer[abs.x - 1][abs.y + 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x - 1][abs.y + 1];
+                squares_used[y] -= 4;
+                total[y] -= 4 * grscent[abs.x - 1][abs.y + 1];
             }
             if( blocked_cache[abs.x - 1][abs.y - 1].nw && scent_transfer[abs.x - 1][abs.y - 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x - 1][abs.y - 1];
+                squares_used[y] -= 4;
+                total[y] -= 4 * grscent[abs.x - 1][abs.y - 1];
             }
             if( blocked_cache[abs.x + 1][abs.y - 1].ne && scent_transfer[abs.x + 1][abs.y - 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x + 1][abs.y - 1];
+                squares_used[y] -= 4;
+                total[y] -= 4 * grscent[abs.x + 1][abs.y - 1];
             }
+        }
 
-            //Lingering scent
-            int temp_scent =  grscent[abs.x][abs.y] * ( 250 - squares_used  *
-                              scent_transfer[abs.x][abs.y] ) ;
-            temp_scent -=  grscent[abs.x][abs.y] * scent_transfer[abs.x][abs.y] *
-                           ( 45 - squares_used ) / 5;
-
-            new_scent[y][x] = ( temp_scent + total * scent_transfer[abs.x][abs.y] ) / 250;
+        scent_kernels::diffuse( &scent_transfer[abs_x][min.y], &grscent[abs_x][min.y],
+                                total.data(), squares_used.data(), new_scent[x].data(), height );
+    }
 
+    point new_min( MAPSIZE_X, MAPSIZE_Y );
+    point new_max( -1, -1 );
+    for( int x = 1; x < width + 1; ++x ) {
+        const int abs_x = x + min.x - 1;
+        std::copy_n( new_scent[x].begin(), height, &grscent[abs_x][min.y] );
+        for( int y = 0; y < height; ++y ) {
+            if( new_scent[x][y] != 0 ) {
+                new_min = point( std::min( new_min.x, abs_x ), std::min( new_min.y, y + min.y ) );
+                new_max = point( std::max( new_max.x, abs_x ), std::max( new_max.y, y + min.y ) );
+            }
         }
     }
-    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-            grscent[x + scentmap_minx - 1 ][y + scentmap_miny] = new_scent[y][x];
-        }
+
+    // Scent outside of the scent radius was left alone, so the old area has to be kept
+    const inclusive_rectangle<point> updated( min, max );
+    if( updated.contains( active_min ) && updated.contains( active_max ) ) {
+        active_min = new_min;
+        active_max = new_max;
+    } else {
+        active_min = point( std::min( active_min.x, new_min.x ),
+                            std::min( active_min.y, new_min.y ) );
+        active_max = point( std::max( active_max.x, new_max.x ),
+                            std::max( active_max.y, new_max.y ) );
     }
 }
 
@@ -44,12 +44,19 @@ class scent_map
         using scent_array = std::array<std::array<T, MAPSIZE_Y>, MAPSIZE_X>;
 
         scent_array<int> grscent;
+        // Bounding box of the tiles that may hold scent, empty when min > max.
+        // Everything outside of it is 0, so update and decay can skip it.
+        point active_min = point_zero;
+        point active_max = point( MAPSIZE_X - 1, MAPSIZE_Y - 1 );
         scenttype_id typescent;
         std::optional<tripoint> player_last_position;
         time_point player_last_moved = calendar::before_time_starts;
 
         const game &gm;
 
+        /** Shrinks the active area to fit the scent currently in it. */
+        void fit_active_area();
+
     public:
         scent_map( const game &g ) : gm( g ) { }
 
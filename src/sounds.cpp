@@ -1,6 +1,7 @@
 #include "sounds.h"
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cmath>
 #include <cstdlib>
@@ -11,6 +12,7 @@
 #include <system_error>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "avatar.h"
 #include "bodypart.h"
@@ -18,6 +20,7 @@
 #include "calendar.h"
 #include "coordinate_conversions.h"
 #include "creature.h"
+#include "creature_tracker.h"
 #include "debug.h"
 #include "effect.h"
 #include "enums.h"
@@ -188,10 +191,10 @@ static std::unordered_map<tripoint, sound_event> sound_markers;
 // My research indicates that attenuation through soil-like materials is as
 // high as 100x the attenuation through air, plus vertical distances are
 // roughly five times as large as horizontal ones.
-static int sound_distance( const tripoint &source, const tripoint &sink )
+static int vertical_sound_attenuation( const int source_z, const int sink_z )
 {
-    const int lower_z = std::min( source.z, sink.z );
-    const int upper_z = std::max( source.z, sink.z );
+    const int lower_z = std::min( source_z, sink_z );
+    const int upper_z = std::max( source_z, sink_z );
     const int vertical_displacement = upper_z - lower_z;
     int vertical_attenuation = vertical_displacement;
     if( lower_z < 0 && vertical_displacement > 0 ) {
@@ -203,7 +206,12 @@ static int sound_distance( const tripoint &source, const tripoint &sink )
     }
     // Regardless of underground effects, scale the vertical distance by 5x.
     vertical_attenuation *= 5;
-    return rl_dist( source.xy(), sink.xy() ) + vertical_attenuation;
+    return vertical_attenuation;
+}
+
+static int sound_distance( const tripoint &source, const tripoint &sink )
+{
+    return rl_dist( source.xy(), sink.xy() ) + vertical_sound_attenuation( source.z, sink.z );
 }
 
 void sounds::ambient_sound( const tripoint &p, int vol, sound_t category,
@@ -363,13 +371,26 @@ void sounds::process_sounds()
             overmap_buffer.signal_hordes( target, sig_power );
         }
         // Alert all monsters (that can hear) to the sound.
-        for( monster &critter : g->all_monsters() ) {
+        // Exclude monsters that certainly won't hear the sound
+        if( vol <= 0 ) {
+            continue;
+        }
+        std::array<int, OVERMAP_LAYERS> attenuation;
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+            attenuation[z + OVERMAP_DEPTH] = vertical_sound_attenuation( source.z, z );
+        }
+        const auto distance_to = [&]( const monster & critter ) {
+            const tripoint &pos = critter.pos();
+            return rl_dist( source.xy(), pos.xy() ) + attenuation[pos.z + OVERMAP_DEPTH];
+        };
+        // Sound distance is never shorter than the plain distance
+        const std::vector<monster *> listeners = g->critter_tracker->monsters_in_radius(
+        source, vol * 2 - 1, [&]( const monster & critter ) {
+            return vol * 2 > distance_to( critter );
+        } );
+        for( monster *critter : listeners ) {
             // TODO: Generalize this to Creature::hear_sound
-            const int dist = sound_distance( source, critter.pos() );
-            if( vol * 2 > dist ) {
-                // Exclude monsters that certainly won't hear the sound
-                critter.hear_sound( source, vol, dist );
-            }
+            critter->hear_sound( source, vol, distance_to( *critter ) );
         }
     }
     recent_sounds.clear();
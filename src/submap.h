@@ -24,6 +24,11 @@
 class JsonIn;
 class JsonOut;
 class map;
+namespace cata
+{
+class binary_reader;
+class binary_writer;
+} // namespace cata
 struct trap;
 struct ter_t;
 struct furn_t;
@@ -217,6 +222,14 @@ class submap : maptile_soa<SEEX, SEEY>
         void store( JsonOut &jsout ) const;
         void load( JsonIn &jsin, const std::string &member_name, int version, const tripoint offset );
 
+        /**
+         * Compact counterpart of @ref store and @ref load. The per-tile terrain, furniture,
+         * trap and radiation planes are run-length encoded, with ids written once into
+         * a table and referred to by index. Everything else is embedded as JSON.
+         */
+        void store_binary( cata::binary_writer &out ) const;
+        void load_binary( cata::binary_reader &in, int version, const tripoint &offset );
+
         // If is_uniform is true, this submap is a solid block of terrain
         // Uniform submaps aren't saved/loaded, because regenerating them is faster
         bool is_uniform;
@@ -245,6 +258,8 @@ class submap : maptile_soa<SEEX, SEEY>
         int temperature = 0;
 
         void update_legacy_computer();
+        /** Members of @ref store other than the per-tile planes */
+        void store_contents( JsonOut &jsout ) const;
 
         static constexpr size_t elements = SEEX * SEEY;
 };
@@ -0,0 +1,50 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+thread_pool::thread_pool( size_t num_threads )
+{
+    workers.reserve( num_threads );
+    for( size_t i = 0; i < num_threads; i++ ) {
+        workers.emplace_back( &thread_pool::worker_loop, this );
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lk( mutex );
+        stopping = true;
+    }
+    jobs_cv.notify_all();
+    for( std::thread &t : workers ) {
+        t.join();
+    }
+}
+
+void thread_pool::worker_loop()
+{
+    while( true ) {
+        std::move_only_function<void()> job;
+        {
+            std::unique_lock<std::mutex> lk( mutex );
+            jobs_cv.wait( lk, [this] {
+                return stopping || !jobs.empty();
+            } );
+            // Drain the queue before stopping so no future is left without a value.
+            if( jobs.empty() ) {
+                return;
+            }
+            job = std::move( jobs.front() );
+            jobs.pop_front();
+        }
+        job();
+    }
+}
+
+thread_pool &get_thread_pool()
+{
+    // hardware_concurrency() may report 0 when it cannot tell
+    static thread_pool pool( std::max( 2u, std::thread::hardware_concurrency() ) - 1 );
+    return pool;
+}
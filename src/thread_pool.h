@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * A fixed set of worker threads consuming jobs from a shared queue.
+ *
+ * Jobs must not touch game state that the main thread may be mutating at the
+ * same time; the pool is meant for self-contained work such as compression or
+ * filling caches from immutable inputs.
+ */
+class thread_pool
+{
+    public:
+        explicit thread_pool( size_t num_threads );
+        ~thread_pool();
+
+        thread_pool( const thread_pool & ) = delete;
+        thread_pool &operator=( const thread_pool & ) = delete;
+
+        /** Queue @p f to be run on a worker. The returned future yields its result. */
+        template<typename F>
+        auto submit( F &&f ) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+            using result_t = std::invoke_result_t<std::decay_t<F>>;
+            std::packaged_task<result_t()> task( std::forward<F>( f ) );
+            std::future<result_t> result = task.get_future();
+            {
+                std::lock_guard<std::mutex> lk( mutex );
+                jobs.emplace_back( std::move( task ) );
+            }
+            jobs_cv.notify_one();
+            return result;
+        }
+
+        size_t size() const {
+            return workers.size();
+        }
+
+    private:
+        void worker_loop();
+
+        std::vector<std::thread> workers;
+        std::deque<std::move_only_function<void()>> jobs;
+        std::mutex mutex;
+        std::condition_variable jobs_cv;
+        bool stopping = false;
+};
+
+/**
+ * Shared pool sized to the machine, leaving one core for the main thread.
+ * Created on first use.
+ */
+thread_pool &get_thread_pool();
+
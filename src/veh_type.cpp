@@ -467,6 +467,19 @@ void vpart_info::finalize()
             info.set_flag( "FOLDABLE" );
         }
 
+        // add the base item to the installation requirements
+        // TODO: support multiple/alternative base items
+        requirement_data ins;
+        ins.components.push_back( { { { info.item, 1 } } } );
+
+        const requirement_id ins_id( std::string( "inline_vehins_base_" ) + info.id.str() );
+        requirement_data::save_requirement( ins, ins_id );
+        info.install_reqs.emplace_back( ins_id, 1 );
+
+        if( info.removal_moves < 0 ) {
+            info.removal_moves = info.install_moves / 2;
+        }
+
         for( const auto &f : info.flags ) {
             auto b = vpart_bitflag_map.find( f );
             if( b != vpart_bitflag_map.end() ) {
@@ -525,19 +538,6 @@ void vpart_info::check()
     for( auto &vp : vpart_info_all ) {
         auto &part = vp.second;
 
-        // add the base item to the installation requirements
-        // TODO: support multiple/alternative base items
-        requirement_data ins;
-        ins.components.push_back( { { { part.item, 1 } } } );
-
-        const requirement_id ins_id( std::string( "inline_vehins_base_" ) + part.id.str() );
-        requirement_data::save_requirement( ins, ins_id );
-        part.install_reqs.emplace_back( ins_id, 1 );
-
-        if( part.removal_moves < 0 ) {
-            part.removal_moves = part.install_moves / 2;
-        }
-
         for( const auto &[skill, level] : part.install_skills ) {
             if( !skill.is_valid() ) {
                 debugmsg( "vehicle part %s has unknown install skill %s", part.id.c_str(), skill.c_str() );
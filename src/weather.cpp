@@ -1152,9 +1152,35 @@ auto weather_manager::get_water_temperature( const tripoint & ) const -> units::
     return water_temperature;
 }
 
+auto weather_manager::get_weather_temperature( const tripoint_abs_ms &location,
+        const time_point &t ) const -> units::temperature
+{
+    const point_abs_omt omt = project_to<coords::omt>( location.xy() );
+    const int hour = to_hours<int>( t - calendar::turn_zero );
+    std::unordered_map<int, units::temperature> &timeline = weather_temperature_cache[omt];
+    const auto emplaced = timeline.try_emplace( hour );
+    if( emplaced.second ) {
+        emplaced.first->second = get_cur_weather_gen().get_weather_temperature(
+                                     tripoint_abs_ms( project_to<coords::ms>( omt ), 0 ),
+                                     calendar::turn_zero + time_duration::from_hours( hour ),
+                                     calendar::config, g->get_seed() );
+    }
+    return emplaced.first->second;
+}
+
+size_t weather_manager::cached_weather_temperatures() const
+{
+    size_t count = 0;
+    for( const auto &timeline : weather_temperature_cache ) {
+        count += timeline.second.size();
+    }
+    return count;
+}
+
 void weather_manager::clear_temp_cache()
 {
     temperature_cache.clear();
+    weather_temperature_cache.clear();
 }
 
 namespace weather
@@ -209,6 +209,10 @@ class weather_manager
         auto get_temperature( const tripoint_abs_omt &location ) const -> units::temperature;
         // Returns water temperature of given location (in local coords).
         auto get_water_temperature( const tripoint &location ) const -> units::temperature;
+        // Returns the weather temperature of the overmap tile at the given absolute location at the
+        // start of the hour `t` falls in, without local modifiers. See weather_temperature_cache.
+        auto get_weather_temperature( const tripoint_abs_ms &location,
+                                      const time_point &t ) const -> units::temperature;
         void clear_temp_cache();
 
         // Get precise weather data
@@ -220,10 +224,19 @@ class weather_manager
         void override_humidity( int h ) {
             weather_precise.humidity = h;
         }
+        // For use in tests
+        size_t cached_weather_temperatures() const;
 
     private:
         // Cached weather data
         w_point weather_precise;
+        /**
+         * Hourly weather temperatures of overmap tiles, by hours since turn zero, cleared every
+         * turn like temperature_cache. Items catching up on rot hour by hour after a long time
+         * away from the reality bubble all need the same ones.
+         */
+        mutable std::unordered_map<point_abs_omt, std::unordered_map<int, units::temperature>>
+                weather_temperature_cache;
 };
 
 weather_manager &get_weather();
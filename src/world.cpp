@@ -4,21 +4,99 @@
 #include <sstream>
 #include <cstring>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
 
 #include "game.h"
 #include "avatar.h"
 #include "debug.h"
 #include "cata_utility.h"
 #include "filesystem.h"
+#include "map_quad_prefetcher.h"
 #include "output.h"
 #include "worldfactory.h"
 #include "mod_manager.h"
 #include "path_info.h"
 #include "compress.h"
 #include "sqlite3.h"
+#include "thread_pool.h"
 #include "zlib.h"
 
 #define dbg(x) DebugLogFL((x),DC::Main)
+
+static constexpr const char *file_exist_sql = "SELECT count() FROM files WHERE path = :path";
+
+static constexpr const char *write_file_sql = R"sql(
+    INSERT INTO files(path, parent, data, compression)
+    VALUES (:path, :parent, :data, :compression)
+    ON CONFLICT(path) DO UPDATE
+        SET data = excluded.data,
+            parent = excluded.parent,
+            compression = excluded.compression;
+)sql";
+
+static constexpr const char *read_file_sql =
+    "SELECT data, compression FROM files WHERE path = :path LIMIT 1";
+
+static constexpr const char *read_dictionary_sql = "SELECT data FROM dictionaries WHERE id = :id";
+
+static constexpr const char *latest_dictionary_sql =
+    "SELECT id, data FROM dictionaries ORDER BY id DESC LIMIT 1";
+
+static constexpr const char *write_dictionary_sql = "INSERT INTO dictionaries(data) VALUES (:data)";
+
+/** Value of the compression column for blobs compressed with a preset dictionary. */
+static constexpr const char *zlib_dict_prefix = "zlib_dict:";
+
+/** Per database handle state that outlives a single query. */
+struct db_cache {
+    /**
+     * Prepared statements keyed by the address of one of the SQL strings above.
+     * Saving writes one row per map quad, so re-preparing the same statement for
+     * each of them adds up quickly.
+     */
+    std::map<const char *, sqlite3_stmt *> statements;
+    /** Compression dictionaries already read from the dictionaries table, by id */
+    std::map<int, std::shared_ptr<const std::string>> dictionaries;
+};
+
+static std::map<sqlite3 *, db_cache> db_caches;
+static std::mutex db_caches_mutex;
+
+static sqlite3_stmt *get_cached_stmt( sqlite3 *db, const char *sql )
+{
+    std::lock_guard<std::mutex> lk( db_caches_mutex );
+    sqlite3_stmt *&stmt = db_caches[db].statements[sql];
+    if( stmt == nullptr &&
+        sqlite3_prepare_v3( db, sql, -1, SQLITE_PREPARE_PERSISTENT, &stmt, nullptr ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
+        stmt = nullptr;
+        throw std::runtime_error( "DB query failed" );
+    }
+    return stmt;
+}
+
+/** Returns a cached statement to its initial state once it goes out of scope. */
+class stmt_reset_guard
+{
+    public:
+        explicit stmt_reset_guard( sqlite3_stmt *stmt ) : stmt( stmt ) {}
+        stmt_reset_guard( const stmt_reset_guard & ) = delete;
+        stmt_reset_guard &operator=( const stmt_reset_guard & ) = delete;
+        ~stmt_reset_guard() {
+            sqlite3_reset( stmt );
+            sqlite3_clear_bindings( stmt );
+        }
+    private:
+        sqlite3_stmt *stmt;
+};
+
 static sqlite3 *open_db( const std::string &path )
 {
     sqlite3 *db = nullptr;
@@ -36,25 +114,80 @@ static sqlite3 *open_db( const std::string &path )
         throw std::runtime_error( "Failed to open db" );
     }
 
+    // WAL lets a save commit with a single sequential append to the log instead of
+    // rewriting pages in place, and NORMAL sync is still crash-safe in that mode.
     auto sql = R"sql(
+        PRAGMA journal_mode = WAL;
+        PRAGMA synchronous = NORMAL;
         CREATE TABLE IF NOT EXISTS files (
             path           TEXT PRIMARY KEY NOT NULL,
             parent         TEXT NOT NULL,
             compression    TEXT DEFAULT NULL,
             data           BLOB NOT NULL
         );
+        CREATE TABLE IF NOT EXISTS dictionaries (
+            id             INTEGER PRIMARY KEY,
+            data           BLOB NOT NULL
+        );
     )sql";
 
     char *sqlErrMsg = 0;
     ret = sqlite3_exec( db, sql, NULL, NULL, &sqlErrMsg );
     if( ret != SQLITE_OK ) {
         dbg( DL::Error ) << "Failed to init db" << path << " (" << sqlErrMsg << ")";
+        sqlite3_free( sqlErrMsg );
         throw std::runtime_error( "Failed to open db" );
     }
 
     return db;
 }
 
+static void close_db( sqlite3 *db )
+{
+    std::lock_guard<std::mutex> lk( db_caches_mutex );
+    const auto iter = db_caches.find( db );
+    if( iter != db_caches.end() ) {
+        for( auto &stmt : iter->second.statements ) {
+            sqlite3_finalize( stmt.second );
+        }
+        db_caches.erase( iter );
+    }
+    sqlite3_close( db );
+}
+
+static std::shared_ptr<const std::string> get_dictionary( sqlite3 *db, int id )
+{
+    {
+        std::lock_guard<std::mutex> lk( db_caches_mutex );
+        const auto &dictionaries = db_caches[db].dictionaries;
+        const auto iter = dictionaries.find( id );
+        if( iter != dictionaries.end() ) {
+            return iter->second;
+        }
+    }
+
+    sqlite3_stmt *stmt = get_cached_stmt( db, read_dictionary_sql );
+    stmt_reset_guard guard( stmt );
+    if( sqlite3_bind_int( stmt, sqlite3_bind_parameter_index( stmt, ":id" ), id ) != SQLITE_OK ||
+        sqlite3_step( stmt ) != SQLITE_ROW ) {
+        throw std::runtime_error( string_format( "Missing compression dictionary %d", id ) );
+    }
+    auto dictionary = std::make_shared<const std::string>(
+                          static_cast<const char *>( sqlite3_column_blob( stmt, 0 ) ),
+                          sqlite3_column_bytes( stmt, 0 ) );
+
+    std::lock_guard<std::mutex> lk( db_caches_mutex );
+    db_caches[db].dictionaries[id] = dictionary;
+    return dictionary;
+}
+
+static int64_t now_us()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()
+           ).count();
+}
+
 save_t::save_t( const std::string &name ): name( name ) {}
 
 std::string save_t::decoded_name() const
@@ -219,7 +352,7 @@ bool WORLDINFO::save( const bool is_conversion ) const
     if( world_save_format == save_format::V2_COMPRESSED_SQLITE3 &&
         !file_exist( folder_path() + "/map.sqlite3" ) ) {
         sqlite3 *db = open_db( folder_path() + "/map.sqlite3" );
-        sqlite3_close( db );
+        close_db( db );
     }
     return true;
 }
@@ -269,102 +402,255 @@ void load_external_option( const JsonObject &jo )
 
 static bool file_exist_in_db( sqlite3 *db, const std::string &path )
 {
-    int fileCount = 0;
-    const char *sql = "SELECT count() FROM files WHERE path = :path";
-    sqlite3_stmt *stmt = nullptr;
-
-    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
-        throw std::runtime_error( "DB query failed" );
-    }
+    sqlite3_stmt *stmt = get_cached_stmt( db, file_exist_sql );
+    stmt_reset_guard guard( stmt );
 
     if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
                            SQLITE_TRANSIENT ) != SQLITE_OK ) {
         dbg( DL::Error ) << "Failed to bind parameter: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
         throw std::runtime_error( "DB query failed" );
     }
 
-    if( sqlite3_step( stmt ) == SQLITE_ROW ) {
-        // Retrieve the count result
-        fileCount = sqlite3_column_int( stmt, 0 );
-    } else {
+    if( sqlite3_step( stmt ) != SQLITE_ROW ) {
         dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
         throw std::runtime_error( "DB query failed" );
     }
 
-    sqlite3_finalize( stmt );
-
-    return fileCount > 0;
+    return sqlite3_column_int( stmt, 0 ) > 0;
 }
 
-static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn writer )
-{
-    std::ostringstream oss;
-    writer( oss );
-    auto data = oss.str();
+/** A serialized file, compressed and ready to be inserted into a database. */
+struct compressed_file {
+    std::vector<std::byte> data;
+    std::string compression;
+    size_t raw_size = 0;
+    int64_t compress_us = 0;
+};
 
-    std::vector<std::byte> compressedData;
-    zlib_compress( data, compressedData );
+static compressed_file compress_file( const std::string &data, const db_codec &codec )
+{
+    const int64_t start = now_us();
+    compressed_file file;
+    if( codec.dictionary ) {
+        zlib_compress( data, file.data, *codec.dictionary );
+        file.compression = zlib_dict_prefix + std::to_string( codec.dictionary_id );
+    } else {
+        zlib_compress( data, file.data );
+        file.compression = "zlib";
+    }
+    file.raw_size = data.size();
+    file.compress_us = now_us() - start;
+    return file;
+}
 
+/**
+ * Insert or replace @p path with the compressed contents of @p file.
+ * On failure, returns false and stores the reason in @p error.
+ */
+static bool insert_into_db( sqlite3 *db, const std::string &path, const compressed_file &file,
+                            save_tx_stats *stats, std::string &error )
+{
     size_t basePos = path.find_last_of( "/\\" );
     auto parent = ( basePos == std::string::npos ) ? "" : path.substr( 0, basePos );
 
-    auto sql = R"sql(
-        INSERT INTO files(path, parent, data, compression)
-        VALUES (:path, :parent, :data, 'zlib')
-        ON CONFLICT(path) DO UPDATE
-            SET data = excluded.data,
-                parent = excluded.parent,
-                compression = excluded.compression;
-    )sql";
+    const int64_t write_start = now_us();
 
-    sqlite3_stmt *stmt = nullptr;
-
-    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
-        throw std::runtime_error( "DB query failed" );
-    }
+    sqlite3_stmt *stmt = get_cached_stmt( db, write_file_sql );
+    stmt_reset_guard guard( stmt );
 
     if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
-                           SQLITE_TRANSIENT ) != SQLITE_OK ||
+                           SQLITE_STATIC ) != SQLITE_OK ||
         sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":parent" ), parent.c_str(), -1,
-                           SQLITE_TRANSIENT ) != SQLITE_OK ||
-        sqlite3_bind_blob( stmt, sqlite3_bind_parameter_index( stmt, ":data" ), compressedData.data(),
-                           compressedData.size(), SQLITE_TRANSIENT ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to bind parameters: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
-        throw std::runtime_error( "DB query failed" );
+                           SQLITE_STATIC ) != SQLITE_OK ||
+        sqlite3_bind_blob( stmt, sqlite3_bind_parameter_index( stmt, ":data" ), file.data.data(),
+                           file.data.size(), SQLITE_STATIC ) != SQLITE_OK ||
+        sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":compression" ),
+                           file.compression.c_str(), -1, SQLITE_STATIC ) != SQLITE_OK ) {
+        error = std::string( "Failed to bind parameters: " ) + sqlite3_errmsg( db );
+        return false;
     }
 
     if( sqlite3_step( stmt ) != SQLITE_DONE ) {
-        dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
+        error = std::string( "Failed to execute query: " ) + sqlite3_errmsg( db );
+        return false;
     }
-    sqlite3_finalize( stmt );
+
+    if( stats ) {
+        stats->files_written++;
+        stats->raw_bytes += file.raw_size;
+        stats->compressed_bytes += file.data.size();
+        stats->compress_us += file.compress_us;
+        stats->write_us += now_us() - write_start;
+    }
+    return true;
 }
 
-static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn reader,
-                          bool optional )
+static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn writer,
+                         save_tx_stats *stats = nullptr )
 {
-    const char *sql = "SELECT data, compression FROM files WHERE path = :path LIMIT 1";
+    const int64_t serialize_start = now_us();
 
-    sqlite3_stmt *stmt = nullptr;
+    std::ostringstream oss;
+    writer( oss );
+    auto data = oss.str();
 
-    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
-        throw std::runtime_error( "DB query failed" );
+    if( stats ) {
+        stats->serialize_us += now_us() - serialize_start;
     }
 
-    if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
-                           SQLITE_TRANSIENT ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to bind parameter: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
-        throw std::runtime_error( "DB query failed" );
+    std::string error;
+    if( !insert_into_db( db, path, compress_file( data, db_codec() ), stats, error ) ) {
+        dbg( DL::Error ) << error << '\n';
     }
+}
+
+/**
+ * Two-stage writer used while a save transaction is open. Files are serialized by
+ * the caller, compressed on the shared thread pool, and inserted in submission order
+ * by a single thread that owns all database writes until the pipeline is flushed.
+ */
+class save_pipeline
+{
+    public:
+        explicit save_pipeline( save_tx_stats &stats ) : stats( stats ) {}
+        ~save_pipeline() {
+            {
+                std::lock_guard<std::mutex> lk( mutex );
+                stopping = true;
+            }
+            queue_cv.notify_all();
+            if( writer.joinable() ) {
+                writer.join();
+            }
+        }
+
+        save_pipeline( const save_pipeline & ) = delete;
+        save_pipeline &operator=( const save_pipeline & ) = delete;
+
+        void enqueue( sqlite3 *db, const std::string &path, std::string data, const db_codec &codec ) {
+            std::future<compressed_file> blob = get_thread_pool().submit(
+            [data = std::move( data ), codec]() {
+                return compress_file( data, codec );
+            } );
+
+            std::unique_lock<std::mutex> lk( mutex );
+            // Don't let serialized quads pile up in memory faster than they can be written.
+            idle_cv.wait( lk, [this] {
+                return queue.size() < max_queued;
+            } );
+            queue.push_back( pending_file{ db, path, std::move( blob ) } );
+            in_flight++;
+            if( !writer.joinable() ) {
+                writer = std::thread( &save_pipeline::writer_loop, this );
+            }
+            lk.unlock();
+            queue_cv.notify_one();
+        }
+
+        /**
+         * Wait until everything queued so far is in the database.
+         * Rethrows the first exception raised while compressing.
+         */
+        void flush() {
+            std::exception_ptr ex;
+            std::vector<std::string> errs;
+            {
+                std::unique_lock<std::mutex> lk( mutex );
+                idle_cv.wait( lk, [this] {
+                    return in_flight == 0;
+                } );
+                std::swap( ex, failure );
+                std::swap( errs, errors );
+            }
+            for( const std::string &err : errs ) {
+                dbg( DL::Error ) << err << '\n';
+            }
+            if( ex ) {
+                std::rethrow_exception( ex );
+            }
+        }
+
+    private:
+        struct pending_file {
+            sqlite3 *db;
+            std::string path;
+            std::future<compressed_file> blob;
+        };
+
+        void writer_loop() {
+            while( true ) {
+                std::unique_lock<std::mutex> lk( mutex );
+                queue_cv.wait( lk, [this] {
+                    return stopping || !queue.empty();
+                } );
+                if( queue.empty() ) {
+                    return;
+                }
+                pending_file file = std::move( queue.front() );
+                queue.pop_front();
+                lk.unlock();
+                idle_cv.notify_all();
+
+                std::string error;
+                std::exception_ptr ex;
+                try {
+                    if( !insert_into_db( file.db, file.path, file.blob.get(), &stats, error ) ) {
+                        error = file.path + ": " + error;
+                    }
+                } catch( ... ) {
+                    ex = std::current_exception();
+                }
+
+                lk.lock();
+                if( !error.empty() ) {
+                    errors.push_back( std::move( error ) );
+                }
+                if( ex && !failure ) {
+                    failure = ex;
+                }
+                in_flight--;
+                lk.unlock();
+                idle_cv.notify_all();
+            }
+        }
+
+        static constexpr size_t max_queued = 256;
+
+        save_tx_stats &stats;
+        std::deque<pending_file> queue;
+        /** Files queued or being inserted right now */
+        size_t in_flight = 0;
+        bool stopping = false;
+        std::vector<std::string> errors;
+        std::exception_ptr failure;
+        std::mutex mutex;
+        std::condition_variable queue_cv;
+        std::condition_variable idle_cv;
+        std::thread writer;
+};
+
+/** Fetch and decompress the contents of @p path, leaving the statement reset afterwards. */
+static bool read_blob_from_db( sqlite3 *db, const std::string &path, std::string &dataString,
+                               bool optional )
+{
+    {
+        sqlite3_stmt *stmt = get_cached_stmt( db, read_file_sql );
+        stmt_reset_guard guard( stmt );
+
+        if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
+                               SQLITE_STATIC ) != SQLITE_OK ) {
+            dbg( DL::Error ) << "Failed to bind parameter: " << sqlite3_errmsg( db ) << '\n';
+            throw std::runtime_error( "DB query failed" );
+        }
+
+        if( sqlite3_step( stmt ) != SQLITE_ROW ) {
+            if( !optional ) {
+                dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
+                throw std::runtime_error( "DB query failed" );
+            }
+            return false;
+        }
 
-    if( sqlite3_step( stmt ) == SQLITE_ROW ) {
-        // Retrieve the count result
         const void *blobData = sqlite3_column_blob( stmt, 0 );
         int blobSize = sqlite3_column_bytes( stmt, 0 );
         auto compression_raw = sqlite3_column_text( stmt, 1 );
@@ -374,29 +660,32 @@ static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn rea
             return false; // Return an empty string if there's no data
         }
 
-        std::string dataString;
         if( compression.empty() ) {
             dataString = std::string( static_cast<const char *>( blobData ), blobSize );
         } else if( compression == "zlib" ) {
             zlib_decompress( blobData, blobSize, dataString );
+        } else if( compression.starts_with( zlib_dict_prefix ) ) {
+            const int dictionary_id = std::stoi( compression.substr( std::strlen( zlib_dict_prefix ) ) );
+            zlib_decompress( blobData, blobSize, dataString, *get_dictionary( db, dictionary_id ) );
         } else {
             throw std::runtime_error( "Unknown compression format: " + compression );
         }
+    }
+    return true;
+}
 
-        std::istringstream stream( dataString );
-        reader( stream );
-        sqlite3_finalize( stmt );
-    } else {
-        auto err = sqlite3_errmsg( db );
-        sqlite3_finalize( stmt );
-
-        if( !optional ) {
-            dbg( DL::Error ) << "Failed to execute query: " << err << '\n';
-            throw std::runtime_error( "DB query failed" );
-        }
+static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn reader,
+                          bool optional )
+{
+    std::string dataString;
+    if( !read_blob_from_db( db, path, dataString, optional ) ) {
         return false;
     }
 
+    // The statement has been reset by now, so the reader is free to issue further queries.
+    std::istringstream stream( dataString );
+    reader( stream );
+
     return true;
 }
 
@@ -419,6 +708,13 @@ world::world( WORLDINFO *info )
 
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
         map_db = open_db( info->folder_path() + "/map.sqlite3" );
+
+        sqlite3_stmt *stmt = get_cached_stmt( map_db, latest_dictionary_sql );
+        stmt_reset_guard guard( stmt );
+        if( sqlite3_step( stmt ) == SQLITE_ROW ) {
+            map_codec.dictionary_id = sqlite3_column_int( stmt, 0 );
+            map_codec.dictionary = get_dictionary( map_db, map_codec.dictionary_id );
+        }
     } else {
         if( !assure_dir_exist( "/maps" ) ) {
             dbg( DL::Error ) << "Unable to create or open world directory structure: " << info->folder_path();
@@ -432,12 +728,20 @@ world::~world()
         dbg( DL::Error ) << "Save transaction was not committed before world destruction";
     }
 
+    try {
+        flush_pending_writes();
+    } catch( const std::exception &err ) {
+        dbg( DL::Error ) << "Failed to write pending save data: " << err.what();
+    }
+    pipeline.reset();
+    prefetcher.reset();
+
     if( map_db ) {
-        sqlite3_close( map_db );
+        close_db( map_db );
     }
 
     if( save_db ) {
-        sqlite3_close( save_db );
+        close_db( save_db );
     }
 }
 
@@ -449,6 +753,11 @@ void world::start_save_tx()
     save_tx_start_ts = std::chrono::duration_cast< std::chrono::milliseconds >(
                            std::chrono::system_clock::now().time_since_epoch()
                        ).count();
+    save_stats = save_tx_stats();
+
+    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        pipeline = std::make_unique<save_pipeline>( save_stats );
+    }
 
     if( map_db ) {
         sqlite3_exec( map_db, "BEGIN TRANSACTION", NULL, NULL, NULL );
@@ -465,6 +774,22 @@ int64_t world::commit_save_tx()
         throw std::runtime_error( "Attempted to commit a save transaction while none was in progress" );
     }
 
+    try {
+        flush_pending_writes();
+    } catch( const std::exception &err ) {
+        dbg( DL::Error ) << "Failed to write save data: " << err.what();
+    }
+    pipeline.reset();
+
+    if( map_db && wants_map_dictionary() && !map_codec.dictionary ) {
+        // Training takes a while, so it runs in the background and the result is
+        // stored by a later save. Quads keep using plain zlib until then.
+        store_trained_map_dictionary();
+        if( !map_codec.dictionary ) {
+            start_map_dictionary_training();
+        }
+    }
+
     if( map_db ) {
         sqlite3_exec( map_db, "COMMIT", NULL, NULL, NULL );
     }
@@ -478,9 +803,126 @@ int64_t world::commit_save_tx()
                   ).count();
     int64_t duration = now - save_tx_start_ts;
     save_tx_start_ts = 0;
+
+    dbg( DL::Info ) << "Save committed in " << duration << "ms: "
+                    << save_stats.files_written << " files, "
+                    << save_stats.raw_bytes << " bytes serialized into "
+                    << save_stats.compressed_bytes << " bytes, "
+                    << save_stats.serialize_us / 1000 << "ms serializing, "
+                    << save_stats.compress_us / 1000 << "ms compressing, "
+                    << save_stats.write_us / 1000 << "ms writing";
     return duration;
 }
 
+void world::rollback_save_tx()
+{
+    if( save_tx_start_ts == 0 ) {
+        throw std::runtime_error( "Attempted to roll back a save transaction while none was in progress" );
+    }
+
+    // Let the writer thread finish, so nothing lands in the database after the rollback.
+    try {
+        flush_pending_writes();
+    } catch( const std::exception &err ) {
+        dbg( DL::Error ) << "Failed to write save data: " << err.what();
+    }
+    pipeline.reset();
+    dictionary_samples.clear();
+    dictionary_samples_size = 0;
+
+    if( map_db ) {
+        sqlite3_exec( map_db, "ROLLBACK", NULL, NULL, NULL );
+    }
+
+    if( save_db ) {
+        sqlite3_exec( save_db, "ROLLBACK", NULL, NULL, NULL );
+    }
+
+    save_tx_start_ts = 0;
+    dbg( DL::Warn ) << "Save rolled back";
+}
+
+void world::flush_pending_writes() const
+{
+    if( pipeline ) {
+        pipeline->flush();
+    }
+}
+
+void world::write_db_file( sqlite3 *db, const std::string &path, file_write_fn writer,
+                           const db_codec &codec, bool collect_sample ) const
+{
+    const int64_t serialize_start = now_us();
+    std::ostringstream oss;
+    writer( oss );
+    std::string data = std::move( oss ).str();
+    save_stats.serialize_us += now_us() - serialize_start;
+
+    if( collect_sample && dictionary_samples_size < max_dictionary_samples_size ) {
+        dictionary_samples_size += data.size();
+        dictionary_samples.push_back( data );
+    }
+
+    if( pipeline ) {
+        pipeline->enqueue( db, path, std::move( data ), codec );
+        return;
+    }
+
+    std::string error;
+    if( !insert_into_db( db, path, compress_file( data, codec ), &save_stats, error ) ) {
+        dbg( DL::Error ) << error << '\n';
+    }
+}
+
+bool world::wants_map_dictionary() const
+{
+    return info->WORLD_OPTIONS["WORLD_COMPRESSION"].getValue() == "zlib_dict";
+}
+
+void world::start_map_dictionary_training()
+{
+    if( dictionary_training.valid() || dictionary_samples.size() < min_dictionary_samples ) {
+        return;
+    }
+    dictionary_training = get_thread_pool().submit(
+    [samples = std::move( dictionary_samples )]() {
+        return train_zlib_dictionary( samples, max_dictionary_size );
+    } );
+    dictionary_samples.clear();
+    dictionary_samples_size = 0;
+}
+
+void world::store_trained_map_dictionary()
+{
+    if( !dictionary_training.valid() ||
+        dictionary_training.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ) {
+        return;
+    }
+    std::shared_ptr<const std::string> dictionary;
+    try {
+        dictionary = std::make_shared<const std::string>( dictionary_training.get() );
+    } catch( const std::exception &err ) {
+        dbg( DL::Error ) << "Failed to train compression dictionary: " << err.what();
+        return;
+    }
+    if( dictionary->empty() ) {
+        return;
+    }
+
+    sqlite3_stmt *stmt = get_cached_stmt( map_db, write_dictionary_sql );
+    stmt_reset_guard guard( stmt );
+    if( sqlite3_bind_blob( stmt, sqlite3_bind_parameter_index( stmt, ":data" ), dictionary->data(),
+                           dictionary->size(), SQLITE_STATIC ) != SQLITE_OK ||
+        sqlite3_step( stmt ) != SQLITE_DONE ) {
+        dbg( DL::Error ) << "Failed to store compression dictionary: " << sqlite3_errmsg( map_db );
+        return;
+    }
+
+    map_codec.dictionary = dictionary;
+    map_codec.dictionary_id = sqlite3_last_insert_rowid( map_db );
+    dbg( DL::Info ) << "Stored a " << dictionary->size() << " byte map compression dictionary";
+}
+
 /**
  * DOMAIN SPECIFIC: MAP
  */
@@ -496,14 +938,24 @@ static std::string get_quad_filename( const tripoint &om_addr )
     return string_format( "%d.%d.%d.map", om_addr.x, om_addr.y, om_addr.z );
 }
 
-bool world::read_map_quad( const tripoint &om_addr, file_read_json_fn reader ) const
+bool world::read_map_quad( const tripoint &om_addr, file_read_fn reader ) const
 {
     const std::string dirname = get_quad_dirname( om_addr );
     std::string quad_path = dirname + "/" + get_quad_filename( om_addr );
 
     // V2 logic
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        return read_from_db_json( map_db, quad_path, reader, true );
+        bool found = false;
+        std::string data;
+        if( prefetcher && prefetcher->take( quad_path, found, data ) ) {
+            if( found ) {
+                std::istringstream stream( data );
+                reader( stream );
+            }
+            return found;
+        }
+        flush_pending_writes();
+        return read_from_db( map_db, quad_path, reader, true );
     } else {
         if( !file_exist( quad_path ) ) {
             // Fix for old saves where the path was generated using std::stringstream, which
@@ -517,10 +969,44 @@ bool world::read_map_quad( const tripoint &om_addr, file_read_json_fn reader ) c
             }
         }
 
-        return read_from_file_json( quad_path, reader, true );
+        return read_from_file( quad_path, reader, true );
     }
 }
 
+void world::prefetch_map_quads( const std::vector<tripoint> &om_addrs )
+{
+    if( info->world_save_format != save_format::V2_COMPRESSED_SQLITE3 || in_save_tx() ) {
+        return;
+    }
+    if( !prefetcher ) {
+        // The worker reads through a read-only connection of its own
+        std::shared_ptr<sqlite3> db;
+        const std::string db_path = info->folder_path() + "/map.sqlite3";
+        prefetcher = std::make_unique<map_quad_prefetcher>(
+        [db, db_path]( const std::string & path ) mutable -> std::optional<std::string> {
+            if( !db ) {
+                sqlite3 *raw = nullptr;
+                if( sqlite3_open_v2( db_path.c_str(), &raw, SQLITE_OPEN_READONLY, nullptr ) != SQLITE_OK ) {
+                    sqlite3_close( raw );
+                    throw std::runtime_error( "Failed to open db" );
+                }
+                db = std::shared_ptr<sqlite3>( raw, close_db );
+            }
+            std::string contents;
+            if( !read_blob_from_db( db.get(), path, contents, true ) ) {
+                return std::nullopt;
+            }
+            return contents;
+        } );
+    }
+    std::vector<std::string> paths;
+    paths.reserve( om_addrs.size() );
+    for( const tripoint &om_addr : om_addrs ) {
+        paths.push_back( get_quad_dirname( om_addr ) + "/" + get_quad_filename( om_addr ) );
+    }
+    prefetcher->request( paths );
+}
+
 bool world::write_map_quad( const tripoint &om_addr, file_write_fn writer ) const
 {
     const std::string dirname = get_quad_dirname( om_addr );
@@ -528,7 +1014,16 @@ bool world::write_map_quad( const tripoint &om_addr, file_write_fn writer ) cons
 
     // V2 logic
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        write_to_db( map_db, quad_path, writer );
+        if( prefetcher ) {
+            prefetcher->invalidate( quad_path );
+        }
+        if( !wants_map_dictionary() ) {
+            write_db_file( map_db, quad_path, writer );
+        } else {
+            // Until there is a dictionary, quads saved with plain zlib double as training data.
+            write_db_file( map_db, quad_path, writer, map_codec,
+                           !map_codec.dictionary && !dictionary_training.valid() );
+        }
         return true;
     } else {
         assure_dir_exist( dirname );
@@ -553,6 +1048,7 @@ std::string world::overmap_player_filename( const point_abs_om &p ) const
 bool world::overmap_exists( const point_abs_om &p ) const
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        flush_pending_writes();
         return file_exist_in_db( map_db, overmap_terrain_filename( p ) );
     } else {
         return file_exist( overmap_terrain_filename( p ) );
@@ -562,6 +1058,7 @@ bool world::overmap_exists( const point_abs_om &p ) const
 bool world::read_overmap( const point_abs_om &p, file_read_fn reader ) const
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        flush_pending_writes();
         return read_from_db( map_db, overmap_terrain_filename( p ), reader, true );
     } else {
         return read_from_file( overmap_terrain_filename( p ), reader, true );
@@ -572,6 +1069,7 @@ bool world::read_overmap_player_visibility( const point_abs_om &p, file_read_fn
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
         sqlite3 *playerdb = get_player_db();
+        flush_pending_writes();
         return read_from_db( playerdb, overmap_player_filename( p ), reader, true );
     } else {
         return read_from_player_file( overmap_player_filename( p ), reader, true );
@@ -581,7 +1079,7 @@ bool world::read_overmap_player_visibility( const point_abs_om &p, file_read_fn
 bool world::write_overmap( const point_abs_om &p, file_write_fn writer ) const
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        write_to_db( map_db, overmap_terrain_filename( p ), writer );
+        write_db_file( map_db, overmap_terrain_filename( p ), writer );
         return true;
     } else {
         return write_to_file( overmap_terrain_filename( p ), writer );
@@ -592,7 +1090,7 @@ bool world::write_overmap_player_visibility( const point_abs_om &p, file_write_f
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
         sqlite3 *playerdb = get_player_db();
-        write_to_db( playerdb, overmap_player_filename( p ), writer );
+        write_db_file( playerdb, overmap_player_filename( p ), writer );
         return true;
     } else {
         return write_to_player_file( overmap_player_filename( p ), writer );
@@ -611,6 +1109,7 @@ bool world::read_player_mm_quad( const tripoint &p, file_read_json_fn reader )
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
         sqlite3 *playerdb = get_player_db();
+        flush_pending_writes();
         return read_from_db_json( playerdb, get_mm_filename( p ), reader, true );
     } else {
         return read_from_player_file_json( ".mm1/" + get_mm_filename( p ), reader, true );
@@ -621,7 +1120,7 @@ bool world::write_player_mm_quad( const tripoint &p, file_write_fn writer )
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
         sqlite3 *playerdb = get_player_db();
-        write_to_db( playerdb, get_mm_filename( p ), writer );
+        write_db_file( playerdb, get_mm_filename( p ), writer );
         return true;
     } else {
         const std::string descr = string_format(
@@ -647,6 +1146,10 @@ sqlite3 *world::get_player_db()
     if( !save_db ) {
         save_db = open_db( info->folder_path() + "/" + get_player_path() + ".sqlite3" );
         last_save_id = g->u.get_save_id();
+        // Opened in the middle of a save, so join the transaction the other db is in.
+        if( in_save_tx() ) {
+            sqlite3_exec( save_db, "BEGIN TRANSACTION", NULL, NULL, NULL );
+        }
     }
 
     if( last_save_id != g->u.get_save_id() ) {
@@ -781,7 +1284,7 @@ void world::convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world )
             if( save_id != last_save_id ) {
                 if( last_save_db ) {
                     sqlite3_exec( last_save_db, "COMMIT", NULL, NULL, NULL );
-                    sqlite3_close( last_save_db );
+                    close_db( last_save_db );
                 }
                 last_save_db = open_db( info->folder_path() + "/" + save_id + ".sqlite3" );
                 last_save_id = save_id;
@@ -822,7 +1325,7 @@ void world::convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world )
 
     if( last_save_db ) {
         sqlite3_exec( last_save_db, "COMMIT", NULL, NULL, NULL );
-        sqlite3_close( last_save_db );
+        close_db( last_save_db );
     }
 
     sqlite3_exec( map_db, "COMMIT", NULL, NULL, NULL );
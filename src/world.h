@@ -1,7 +1,10 @@
 #pragma once
 
 #include <functional>
+#include <future>
+#include <memory>
 #include <string>
+#include <vector>
 #include "json.h"
 #include "options.h"
 #include "type_id.h"
@@ -9,8 +12,41 @@
 #include "fstream_utils.h"
 
 class avatar;
+class map_quad_prefetcher;
+class save_pipeline;
 class sqlite3;
 
+/**
+ * How files written to a world database get compressed. The compression column of
+ * each row records which codec was used, so rows written with different codecs
+ * (including by older versions) can be read back side by side.
+ */
+struct db_codec {
+    /** Preset dictionary shared by all files using this codec, or null for plain zlib */
+    std::shared_ptr<const std::string> dictionary;
+    /** Row id of @ref dictionary in the dictionaries table of the database */
+    int dictionary_id = 0;
+};
+
+/**
+ * Counters collected while a save transaction is open, so the time spent in
+ * each stage of a save can be reported once it is committed.
+ */
+struct save_tx_stats {
+    /** Number of files (map quads, overmaps, ...) written to a database */
+    int files_written = 0;
+    /** Bytes of serialized data before compression */
+    size_t raw_bytes = 0;
+    /** Bytes of compressed data handed to the database */
+    size_t compressed_bytes = 0;
+    /** Microseconds spent serializing, on the thread issuing the writes */
+    int64_t serialize_us = 0;
+    /** Microseconds spent compressing, summed over all threads doing it */
+    int64_t compress_us = 0;
+    /** Microseconds spent binding and stepping insert statements */
+    int64_t write_us = 0;
+};
+
 class save_t
 {
     private:
@@ -103,15 +139,38 @@ class world
         /**@{*/
         void start_save_tx();
         int64_t commit_save_tx();
+        /**
+         * Abandon the save transaction, discarding everything written to the databases
+         * since it started. Files written by the V1 save system stay as they are.
+         */
+        void rollback_save_tx();
         /**@}*/
 
+        /** Whether a save transaction is currently open. */
+        bool in_save_tx() const {
+            return save_tx_start_ts != 0;
+        }
+
+        /**
+         * While a save transaction is open, database writes are compressed and inserted
+         * in the background. Block until all of them have landed.
+         * Rethrows any error raised while compressing.
+         */
+        void flush_pending_writes() const;
+
         /*
          * Targeted/domain-specific file operations. Different save formats may choose to
          * lay out files differently, so centralize file placement logic here rather than
          * scattering it throughout the codebase.
          */
-        bool read_map_quad( const tripoint &om_addr, file_read_json_fn reader ) const;
+        bool read_map_quad( const tripoint &om_addr, file_read_fn reader ) const;
         bool write_map_quad( const tripoint &om_addr, file_write_fn writer ) const;
+        /**
+         * Start reading these map quads in the background, replacing any earlier request
+         * that hasn't been served yet. A later @ref read_map_quad of one of them picks up
+         * the prefetched data instead of going to the database.
+         */
+        void prefetch_map_quads( const std::vector<tripoint> &om_addrs );
 
         bool overmap_exists( const point_abs_om &p ) const;
         bool read_overmap( const point_abs_om &p, file_read_fn reader ) const;
@@ -168,6 +227,34 @@ class world
     private:
         /** If non-zero, indicates we're in the middle of a save event */
         int64_t save_tx_start_ts = 0;
+        /** Statistics for the save transaction in progress */
+        mutable save_tx_stats save_stats;
+        /** Background writer, present only while a save transaction is open */
+        std::unique_ptr<save_pipeline> pipeline;
+        /** Background reader for map quads, created on the first prefetch request */
+        std::unique_ptr<map_quad_prefetcher> prefetcher;
+
+        /** Codec used for map quads, carrying the newest trained dictionary if there is one */
+        db_codec map_codec;
+        /** Serialized map quads collected to train a dictionary once the save completes */
+        mutable std::vector<std::string> dictionary_samples;
+        mutable size_t dictionary_samples_size = 0;
+        /** Dictionary being trained on the thread pool, stored by the next save */
+        std::future<std::string> dictionary_training;
+
+        static constexpr size_t min_dictionary_samples = 16;
+        static constexpr size_t max_dictionary_samples_size = 1024 * 1024;
+        /** Deflate can only look back 32KiB, and the quads need room of their own */
+        static constexpr size_t max_dictionary_size = 16 * 1024;
+
+        void write_db_file( sqlite3 *db, const std::string &path, file_write_fn writer,
+                            const db_codec &codec = db_codec(), bool collect_sample = false ) const;
+        /** Whether the world options ask for map quads to be compressed with a dictionary */
+        bool wants_map_dictionary() const;
+        /** Hand the collected samples to the thread pool to train a dictionary from */
+        void start_map_dictionary_training();
+        /** Store the dictionary trained since the last save, if it is done, and start using it */
+        void store_trained_map_dictionary();
 
         std::string overmap_terrain_filename( const point_abs_om &p ) const;
         std::string overmap_player_filename( const point_abs_om &p ) const;
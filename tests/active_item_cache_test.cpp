@@ -1,8 +1,12 @@
 #include "catch/catch.hpp"
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <set>
+#include <vector>
 
+#include "active_item_cache.h"
 #include "calendar.h"
 #include "game.h"
 #include "game_constants.h"
@@ -50,3 +54,69 @@ TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
         }
     }
 }
+
+TEST_CASE( "active_item_cache_wakes_items_when_due", "[item]" )
+{
+    active_item_cache cache;
+    item &fast = *item::spawn_temporary( "firecracker_act", calendar::start_of_cataclysm,
+                                         item::default_charges_tag() );
+    fast.activate();
+    item &slow = *item::spawn_temporary( "meat_cooked" );
+    REQUIRE( fast.processing_speed() == 1 );
+    const int speed = slow.processing_speed();
+    REQUIRE( speed > 1 );
+
+    cache.add( fast );
+    cache.add( slow );
+    cache.add( fast );
+    CHECK( cache.get().size() == 2 );
+
+    int fast_runs = 0;
+    int slow_runs = 0;
+    for( int tick = 0; tick < speed * 3; tick++ ) {
+        for( const item *it : cache.get_for_processing() ) {
+            fast_runs += it == &fast;
+            slow_runs += it == &slow;
+        }
+    }
+    CHECK( fast_runs == speed * 3 );
+    // Fewer slow items than their speed, so at least one of them runs each tick
+    CHECK( slow_runs == speed * 3 );
+
+    cache.remove( &slow );
+    CHECK( cache.get() == std::vector<item *> { &fast } );
+    cache.remove( &fast );
+    CHECK( cache.empty() );
+    CHECK( cache.get_for_processing().empty() );
+}
+
+TEST_CASE( "active_item_cache_spreads_slow_items", "[item]" )
+{
+    active_item_cache cache;
+    const int speed = item::spawn_temporary( "meat_cooked" )->processing_speed();
+    REQUIRE( speed > 1 );
+
+    const int count = GENERATE_COPY( 1, speed / 2, speed * 2 );
+    CAPTURE( count );
+    std::vector<item *> slow;
+    for( int i = 0; i < count; i++ ) {
+        slow.push_back( item::spawn_temporary( "meat_cooked" ) );
+        cache.add( *slow.back() );
+    }
+
+    std::map<const item *, int> runs;
+    const int ticks = speed * 3;
+    for( int tick = 0; tick < ticks; tick++ ) {
+        const std::vector<item *> due = cache.get_for_processing();
+        // Like the old round robin, at least one item of the speed runs each tick
+        CHECK( !due.empty() );
+        for( const item *it : due ) {
+            runs[it]++;
+        }
+    }
+    // Each item runs at least once per processing speed, more often if there are few of them
+    const int expected = ticks / std::min( speed, count );
+    for( const item *it : slow ) {
+        CHECK( runs[it] == expected );
+    }
+}
@@ -0,0 +1,55 @@
+#include "catch/catch.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "compress.h"
+#include "string_formatter.h"
+
+static std::string fake_quad( int x, int y )
+{
+    std::string quad = string_format(
+                           R"([{"version":33,"coordinates":[%d,%d,0],"turn_last_touched":5256000,"temperature":0,"terrain":[)",
+                           x, y );
+    for( int i = 0; i < 12; i++ ) {
+        quad += string_format( R"(["t_floor",%d],"t_wall","t_door_c",["t_dirt",%d],)", i + x % 7, 11 - i );
+    }
+    quad += R"("t_grass"],"radiation":[0,144],"furniture":[[3,4,"f_chair"]],"items":[],"traps":[],"fields":[],"cosmetics":[],"spawns":[],"vehicles":[],"partial_constructions":[]}])";
+    return quad;
+}
+
+TEST_CASE( "zlib_roundtrip", "[compress]" )
+{
+    const std::string input = fake_quad( 10, 20 );
+    std::vector<std::byte> compressed;
+    zlib_compress( input, compressed );
+    std::string output;
+    zlib_decompress( compressed.data(), compressed.size(), output );
+    CHECK( output == input );
+}
+
+TEST_CASE( "zlib_dictionary_roundtrip_and_ratio", "[compress]" )
+{
+    std::vector<std::string> samples;
+    for( int i = 0; i < 40; i++ ) {
+        samples.push_back( fake_quad( i * 3, i * 5 ) );
+    }
+    const std::string dictionary = train_zlib_dictionary( samples, 4096 );
+    REQUIRE( !dictionary.empty() );
+    CHECK( dictionary.size() <= 4096 );
+
+    const std::string input = fake_quad( 1000, 2000 );
+    std::vector<std::byte> plain;
+    std::vector<std::byte> with_dict;
+    zlib_compress( input, plain );
+    zlib_compress( input, with_dict, dictionary );
+    CHECK( with_dict.size() < plain.size() );
+
+    std::string output;
+    zlib_decompress( with_dict.data(), with_dict.size(), output, dictionary );
+    CHECK( output == input );
+
+    // A blob that needs a dictionary can't be read without one.
+    CHECK_THROWS( zlib_decompress( with_dict.data(), with_dict.size(), output ) );
+}
@@ -0,0 +1,58 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "creature_tracker.h"
+#include "game.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "point.h"
+#include "state_helpers.h"
+
+static bool contains( const std::vector<monster *> &monsters, const monster &critter )
+{
+    return std::ranges::find( monsters, &critter ) != monsters.end();
+}
+
+TEST_CASE( "monsters_in_radius_follows_monsters", "[creature]" )
+{
+    clear_all_state();
+    const Creature_tracker &tracker = *g->critter_tracker;
+    const tripoint center( 60, 60, 0 );
+
+    monster &near = spawn_test_monster( "mon_zombie", center + tripoint( 2, 0, 0 ) );
+    // On another submap than the center
+    monster &across = spawn_test_monster( "mon_zombie", center + tripoint( -5, 5, 0 ) );
+    monster &far = spawn_test_monster( "mon_zombie", center + tripoint( 20, 0, 0 ) );
+    monster &below = spawn_test_monster( "mon_zombie", center + tripoint( 0, 0, -1 ) );
+
+    std::vector<monster *> found = tracker.monsters_in_radius( center, 5 );
+    CHECK( found.size() == 3 );
+    CHECK( contains( found, near ) );
+    CHECK( contains( found, across ) );
+    CHECK( contains( found, below ) );
+    CHECK_FALSE( contains( found, far ) );
+
+    found = tracker.monsters_in_radius( center, 5, [&]( const monster & mon ) {
+        return &mon != &near;
+    } );
+    CHECK( found.size() == 2 );
+    CHECK_FALSE( contains( found, near ) );
+
+    far.setpos( center + tripoint( 4, 4, 0 ) );
+    near.setpos( center + tripoint( 30, 30, 0 ) );
+    found = tracker.monsters_in_radius( center, 5 );
+    CHECK( contains( found, far ) );
+    CHECK_FALSE( contains( found, near ) );
+
+    g->remove_zombie( across );
+    below.die( nullptr );
+    found = tracker.monsters_in_radius( center, 5 );
+    CHECK( found.size() == 1 );
+    CHECK( contains( found, far ) );
+
+    g->critter_tracker->rebuild_cache();
+    CHECK( tracker.monsters_in_radius( center, 5 ).size() == 1 );
+    CHECK( tracker.monsters_in_radius( center, 60 ).size() == 2 );
+}
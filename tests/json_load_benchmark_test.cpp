@@ -0,0 +1,113 @@
+#include "catch/catch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "filesystem.h"
+#include "json.h"
+#include "mod_manager.h"
+
+#if defined(CATA_TEST_COUNT_ALLOCATIONS)
+// Counts every allocation made through the global operator new, so benchmarks can report
+//   how many allocations the code they measure makes.  This applies to the whole test
+//   binary, so it is only built in with the CATA_TEST_COUNT_ALLOCATIONS CMake option.
+static std::atomic<long long> allocations{ 0 };
+
+void *operator new( std::size_t size )
+{
+    allocations.fetch_add( 1, std::memory_order_relaxed );
+    if( void *p = std::malloc( size == 0 ? 1 : size ) ) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete( void *p ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete( void *p, std::size_t ) noexcept
+{
+    std::free( p );
+}
+#endif
+
+static long long count_allocations()
+{
+#if defined(CATA_TEST_COUNT_ALLOCATIONS)
+    return allocations.load();
+#else
+    return 0;
+#endif
+}
+
+// Describes how many allocations were made since count_allocations() returned @p before
+static std::string allocations_since( long long before )
+{
+#if defined(CATA_TEST_COUNT_ALLOCATIONS)
+    return std::to_string( count_allocations() - before ) + " allocations";
+#else
+    static_cast<void>( before );
+    return "uncounted allocations (configure with -DCATA_TEST_COUNT_ALLOCATIONS=ON)";
+#endif
+}
+
+// Reads every object at the top level of a data file and visits all of its members
+static int read_members( const std::string &path, const std::string &contents )
+{
+    std::istringstream stream( contents );
+    JsonIn jsin( stream, path );
+    int members = 0;
+    const auto read_object = [&members]( const JsonObject & jo ) {
+        jo.allow_omitted_members();
+        for( const JsonMember member : jo ) {
+            static_cast<void>( member );
+            members++;
+        }
+    };
+    if( jsin.test_array() ) {
+        for( JsonObject jo : jsin.get_array() ) {
+            read_object( jo );
+        }
+    } else if( jsin.test_object() ) {
+        read_object( jsin.get_object() );
+    }
+    return members;
+}
+
+TEST_CASE( "bench_json_load_core_data", "[json][benchmark][.]" )
+{
+    const mod_id core = mod_management::get_default_core_content_pack();
+    std::vector<std::pair<std::string, std::string>> files;
+    for( const std::string &path : get_files_from_path( ".json", core->path, true, true ) ) {
+        files.emplace_back( path, read_entire_file( path ) );
+    }
+    REQUIRE_FALSE( files.empty() );
+
+    const auto read_all = [&files]() {
+        int members = 0;
+        for( const std::pair<std::string, std::string> &file : files ) {
+            members += read_members( file.first, file.second );
+        }
+        return members;
+    };
+
+    const long long allocations_before = count_allocations();
+    const auto start = std::chrono::steady_clock::now();
+    const int members = read_all();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    WARN( "Read " << members << " members of " << files.size() << " files in "
+          << std::chrono::duration_cast<std::chrono::milliseconds>( elapsed ).count()
+          << " ms with " << allocations_since( allocations_before ) );
+
+    BENCHMARK( "read core data objects" ) {
+        return read_all();
+    };
+}
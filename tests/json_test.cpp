@@ -249,18 +249,32 @@ TEST_CASE( "translation_text_style_check_error_recovery", "[json][translation]"
 static void test_get_string( const std::string &str, const std::string &json )
 {
     CAPTURE( json );
-    std::istringstream iss( json );
-    JsonIn jsin( iss );
-    CHECK( jsin.get_string() == str );
+    {
+        std::istringstream iss( json );
+        JsonIn jsin( iss );
+        CHECK( jsin.get_string() == str );
+    }
+    {
+        INFO( "from a buffer" );
+        JsonIn jsin( json );
+        CHECK( jsin.get_string() == str );
+    }
 }
 
 template<typename Matcher>
 static void test_get_string_throws_matches( Matcher &&matcher, const std::string &json )
 {
     CAPTURE( json );
-    std::istringstream iss( json );
-    JsonIn jsin( iss );
-    CHECK_THROWS_MATCHES( jsin.get_string(), JsonError, matcher );
+    {
+        std::istringstream iss( json );
+        JsonIn jsin( iss );
+        CHECK_THROWS_MATCHES( jsin.get_string(), JsonError, matcher );
+    }
+    {
+        INFO( "from a buffer" );
+        JsonIn jsin( json );
+        CHECK_THROWS_MATCHES( jsin.get_string(), JsonError, matcher );
+    }
 }
 
 template<typename Matcher>
@@ -481,3 +495,28 @@ TEST_CASE( "serialize_optional", "[json]" )
         test_serialization( v, "[1,2,3]" );
     }
 }
+
+TEST_CASE( "jsonin_from_buffer_reads_like_stream", "[json]" )
+{
+    const std::string json =
+        R"({ "name": "foo", "skipped": [ 1, -2.5e3, "a\"b", { "c": null } ],)" "\n"
+        R"(  "number": 42, "text": "caf\u00e9 …", "flag": true })";
+
+    JsonIn jsin( json );
+    JsonObject jo = jsin.get_object();
+    CHECK( jo.get_string( "name" ) == "foo" );
+    CHECK( jo.get_int( "number" ) == 42 );
+    CHECK( jo.get_string( "text" ) == "café …" );
+    CHECK( jo.get_bool( "flag" ) );
+    CHECK( jo.has_array( "skipped" ) );
+    jo.allow_omitted_members();
+
+    // Seeking back to a member reads it again
+    JsonIn again( json );
+    again.start_object();
+    CHECK( again.get_member_name() == "name" );
+    const int name_pos = again.tell();
+    CHECK( again.get_string() == "foo" );
+    again.seek( name_pos );
+    CHECK( again.get_string() == "foo" );
+}
@@ -0,0 +1,66 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "legacy_pathfinding.h"
+#include "map.h"
+#include "mapdata.h"
+#include "point.h"
+#include "state_helpers.h"
+
+static void set_wall( map &here, int x, int min_y, int max_y, const ter_id &ter )
+{
+    for( int y = min_y; y <= max_y; y++ ) {
+        here.ter_set( tripoint( x, y, 0 ), ter );
+    }
+}
+
+TEST_CASE( "route_across_submaps_follows_terrain_changes", "[pathfind]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const pathfinding_settings settings( 0, 1000, 1000, 0, false, false, true, false, false );
+    const tripoint from( 40, 60, 0 );
+    const tripoint to( 75, 60, 0 );
+
+    REQUIRE_FALSE( here.route( from, to, settings ).empty() );
+
+    set_wall( here, 60, 30, 90, t_wall );
+    CHECK( here.route( from, to, settings ).empty() );
+
+    const tripoint gap( 60, 70, 0 );
+    here.ter_set( gap, t_floor );
+    const std::vector<tripoint> path = here.route( from, to, settings );
+    REQUIRE_FALSE( path.empty() );
+    CHECK( path.back() == to );
+    CHECK( std::ranges::find( path, gap ) != path.end() );
+
+    here.ter_set( gap, t_wall );
+    CHECK( here.route( from, to, settings ).empty() );
+}
+
+// Walls every 8 tiles, with the gap alternating between the top and the bottom
+//   of the area route searches between y 48 and 79
+static void build_zigzag_map( map &here )
+{
+    for( int x = 24; x < 108; x += 8 ) {
+        const bool gap_at_top = x % 16 == 0;
+        set_wall( here, x, gap_at_top ? 52 : 30, gap_at_top ? 100 : 75, t_wall );
+    }
+}
+
+TEST_CASE( "bench_legacy_route", "[pathfind][benchmark][.]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    build_zigzag_map( here );
+    const pathfinding_settings settings( 0, 1000, 10000, 0, false, false, true, false, false );
+    const tripoint from( 16, 64, 0 );
+    const tripoint to( 116, 64, 0 );
+
+    REQUIRE_FALSE( here.route( from, to, settings ).empty() );
+    BENCHMARK( "route through zigzag" ) {
+        return here.route( from, to, settings );
+    };
+}
@@ -0,0 +1,151 @@
+#include "catch/catch.hpp"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "game_constants.h"
+#include "lightmap.h"
+#include "lightmap_kernels.h"
+#include "shadowcasting.h"
+
+namespace
+{
+
+// One level's worth of tiles plus a few, so the kernels also have to handle a partial last batch
+constexpr int num_tiles = MAPSIZE_X * MAPSIZE_Y + 3;
+
+struct random_level {
+    std::vector<float> seen;
+    std::vector<float> camera;
+    std::vector<float> sm;
+    std::vector<float> transparency;
+    std::vector<four_quadrants> lm;
+    std::unique_ptr<bool[]> floor;
+
+    random_level() : seen( num_tiles ), camera( num_tiles ), sm( num_tiles ),
+        transparency( num_tiles ), lm( num_tiles ), floor( new bool[num_tiles] ) {
+        std::mt19937 rng( 42 );
+        std::uniform_real_distribution<float> unit( 0.0f, 1.0f );
+        for( int i = 0; i < num_tiles; ++i ) {
+            seen[i] = unit( rng ) < 0.3f ? 0.0f : unit( rng );
+            camera[i] = unit( rng ) < 0.8f ? 0.0f : unit( rng );
+            sm[i] = unit( rng ) < 0.9f ? 0.0f : unit( rng ) * 20.0f;
+            if( unit( rng ) < 0.2f ) {
+                transparency[i] = LIGHT_TRANSPARENCY_SOLID;
+            } else if( unit( rng ) < 0.5f ) {
+                // Close enough to open air to be snapped to it, or just too far
+                transparency[i] = LIGHT_TRANSPARENCY_OPEN_AIR + ( unit( rng ) - 0.5f ) * 0.0003f;
+            } else {
+                transparency[i] = unit( rng ) * 0.4f;
+            }
+            for( float &v : lm[i].values ) {
+                v = unit( rng ) * 30.0f;
+            }
+            floor[i] = unit( rng ) < 0.3f;
+        }
+    }
+};
+
+} // namespace
+
+TEST_CASE( "lightmap_kernels_match_scalar_versions", "[lightmap][shadowcasting]" )
+{
+    random_level level;
+    const float weather = LIGHT_TRANSPARENCY_OPEN_AIR * 1.1f;
+
+    SECTION( "snap_transparency" ) {
+        std::vector<float> fast = level.transparency;
+        std::vector<float> reference = level.transparency;
+        lightmap_kernels::snap_transparency( fast.data(), num_tiles, LIGHT_TRANSPARENCY_OPEN_AIR,
+                                             weather );
+        lightmap_kernels::scalar::snap_transparency( reference.data(), num_tiles,
+                LIGHT_TRANSPARENCY_OPEN_AIR, weather );
+        CHECK( fast == reference );
+        CHECK( fast != level.transparency );
+    }
+
+    SECTION( "light_from_above" ) {
+        std::vector<float> fast( num_tiles );
+        std::vector<float> reference( num_tiles );
+        lightmap_kernels::light_from_above( level.transparency.data(), level.floor.get(),
+                                            level.lm.data(), fast.data(), num_tiles );
+        lightmap_kernels::scalar::light_from_above( level.transparency.data(), level.floor.get(),
+                level.lm.data(), reference.data(), num_tiles );
+        CHECK( fast == reference );
+    }
+
+    SECTION( "all_open_to_sky and all_shut_off" ) {
+        std::vector<float> open( num_tiles, LIGHT_TRANSPARENCY_OPEN_AIR );
+        std::vector<float> solid( num_tiles, LIGHT_TRANSPARENCY_SOLID );
+        std::unique_ptr<bool[]> no_floor( new bool[num_tiles]() );
+        CHECK( lightmap_kernels::all_open_to_sky( open.data(), no_floor.get(), num_tiles ) );
+        CHECK_FALSE( lightmap_kernels::all_shut_off( open.data(), no_floor.get(), num_tiles ) );
+        CHECK( lightmap_kernels::all_shut_off( solid.data(), no_floor.get(), num_tiles ) );
+        CHECK_FALSE( lightmap_kernels::all_open_to_sky( solid.data(), no_floor.get(), num_tiles ) );
+
+        // A single tile in the partial last batch changes the answer
+        open.back() = LIGHT_TRANSPARENCY_SOLID;
+        solid.back() = LIGHT_TRANSPARENCY_OPEN_AIR;
+        CHECK_FALSE( lightmap_kernels::all_open_to_sky( open.data(), no_floor.get(), num_tiles ) );
+        CHECK_FALSE( lightmap_kernels::all_shut_off( solid.data(), no_floor.get(), num_tiles ) );
+        no_floor[num_tiles - 1] = true;
+        CHECK( lightmap_kernels::all_shut_off( solid.data(), no_floor.get(), num_tiles ) );
+    }
+
+    SECTION( "classify_visibility" ) {
+        std::vector<lit_level> fast( num_tiles );
+        std::vector<lit_level> reference( num_tiles );
+        const int fast_opaque = lightmap_kernels::classify_visibility( level.seen.data(),
+                                level.camera.data(), level.lm.data(), level.sm.data(), level.transparency.data(),
+                                12.0f, LIGHT_AMBIENT_LOW, fast.data(), num_tiles );
+        const int reference_opaque = lightmap_kernels::scalar::classify_visibility( level.seen.data(),
+                                     level.camera.data(), level.lm.data(), level.sm.data(), level.transparency.data(),
+                                     12.0f, LIGHT_AMBIENT_LOW, reference.data(), num_tiles );
+        CHECK( fast_opaque == reference_opaque );
+        CHECK( fast == reference );
+    }
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "lightmap_kernels_benchmark", "[.][lightmap][benchmark]" )
+{
+    random_level level;
+    std::vector<float> transparency = level.transparency;
+    std::vector<float> light( num_tiles );
+    std::vector<lit_level> visibility( num_tiles );
+    const float weather = LIGHT_TRANSPARENCY_OPEN_AIR * 1.1f;
+
+    BENCHMARK( "snap_transparency" ) {
+        lightmap_kernels::snap_transparency( transparency.data(), num_tiles,
+                                             LIGHT_TRANSPARENCY_OPEN_AIR, weather );
+        return transparency[0];
+    };
+    BENCHMARK( "snap_transparency, scalar" ) {
+        lightmap_kernels::scalar::snap_transparency( transparency.data(), num_tiles,
+                LIGHT_TRANSPARENCY_OPEN_AIR, weather );
+        return transparency[0];
+    };
+
+    BENCHMARK( "light_from_above" ) {
+        lightmap_kernels::light_from_above( level.transparency.data(), level.floor.get(),
+                                            level.lm.data(), light.data(), num_tiles );
+        return light[0];
+    };
+    BENCHMARK( "light_from_above, scalar" ) {
+        lightmap_kernels::scalar::light_from_above( level.transparency.data(), level.floor.get(),
+                level.lm.data(), light.data(), num_tiles );
+        return light[0];
+    };
+
+    BENCHMARK( "classify_visibility" ) {
+        return lightmap_kernels::classify_visibility( level.seen.data(), level.camera.data(),
+                level.lm.data(), level.sm.data(), level.transparency.data(), 12.0f, LIGHT_AMBIENT_LOW,
+                visibility.data(), num_tiles );
+    };
+    BENCHMARK( "classify_visibility, scalar" ) {
+        return lightmap_kernels::scalar::classify_visibility( level.seen.data(), level.camera.data(),
+                level.lm.data(), level.sm.data(), level.transparency.data(), 12.0f, LIGHT_AMBIENT_LOW,
+                visibility.data(), num_tiles );
+    };
+}
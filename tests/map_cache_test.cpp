@@ -0,0 +1,75 @@
+#include "catch/catch.hpp"
+
+#include <vector>
+
+#include "cached_options.h"
+#include "cata_utility.h"
+#include "field_type.h"
+#include "game_constants.h"
+#include "map.h"
+#include "mapdata.h"
+#include "point.h"
+#include "state_helpers.h"
+
+namespace
+{
+
+struct level_snapshot {
+    std::vector<bool> outside;
+    std::vector<float> transparency;
+};
+
+std::vector<level_snapshot> build_and_snapshot( map &here, bool parallel )
+{
+    restore_on_out_of_scope<bool> restore_parallel( parallel_map_cache );
+    parallel_map_cache = parallel;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        here.invalidate_map_cache( z );
+    }
+    here.build_map_cache( 0, true );
+
+    std::vector<level_snapshot> levels;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        const level_cache &ch = here.get_cache_ref( z );
+        level_snapshot &level = levels.emplace_back();
+        for( int x = 0; x < MAPSIZE_X; x++ ) {
+            for( int y = 0; y < MAPSIZE_Y; y++ ) {
+                level.outside.push_back( ch.outside_cache[x][y] );
+                level.transparency.push_back( ch.transparency_cache[x][y] );
+            }
+        }
+    }
+    return levels;
+}
+
+} // namespace
+
+TEST_CASE( "parallel_map_cache_matches_serial_build", "[map][lightmap]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    REQUIRE( here.has_zlevels() );
+    const ter_id flat_roof( "t_flat_roof" );
+
+    // A roofed house with a window, with smoke inside and outside it
+    for( int x = 50; x <= 70; x++ ) {
+        for( int y = 50; y <= 70; y++ ) {
+            const bool is_wall = x == 50 || x == 70 || y == 50 || y == 70;
+            here.ter_set( tripoint( x, y, 0 ), is_wall ? t_wall : t_floor );
+            here.ter_set( tripoint( x, y, 1 ), flat_roof );
+        }
+    }
+    here.ter_set( tripoint( 60, 50, 0 ), t_window );
+    here.add_field( tripoint( 55, 55, 0 ), fd_smoke, 3 );
+    here.add_field( tripoint( 45, 45, 0 ), fd_smoke, 2 );
+
+    const std::vector<level_snapshot> serial = build_and_snapshot( here, false );
+    const std::vector<level_snapshot> parallel = build_and_snapshot( here, true );
+    REQUIRE( serial.size() == parallel.size() );
+    for( size_t i = 0; i < serial.size(); i++ ) {
+        const int z = static_cast<int>( i ) - OVERMAP_DEPTH;
+        CAPTURE( z );
+        CHECK( serial[i].outside == parallel[i].outside );
+        CHECK( serial[i].transparency == parallel[i].transparency );
+    }
+}
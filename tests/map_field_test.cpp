@@ -0,0 +1,96 @@
+#include "catch/catch.hpp"
+
+#include <vector>
+
+#include "cached_options.h"
+#include "calendar.h"
+#include "cata_utility.h"
+#include "field.h"
+#include "field_type.h"
+#include "map.h"
+#include "point.h"
+#include "rng.h"
+#include "state_helpers.h"
+
+TEST_CASE( "process_fields_ages_fields_on_listed_tiles", "[field]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint first( 30, 30, 0 );
+    const tripoint second( 31, 30, 0 );
+    const tripoint far_away( 100, 90, 0 );
+
+    here.add_field( first, fd_blood, 1, 1_turns );
+    here.add_field( second, fd_blood, 1, 1_turns );
+    here.add_field( far_away, fd_blood, 1, 1_turns );
+
+    SECTION( "fields added to the map" ) {
+        here.process_fields();
+        CHECK( here.get_field_age( first, fd_blood ) == 2_turns );
+        CHECK( here.get_field_age( second, fd_blood ) == 2_turns );
+        CHECK( here.get_field_age( far_away, fd_blood ) == 2_turns );
+    }
+
+    SECTION( "fields found by scanning a submap again" ) {
+        here.set_field_tiles_unlisted( 0 );
+        here.process_fields();
+        here.process_fields();
+        CHECK( here.get_field_age( first, fd_blood ) == 3_turns );
+        CHECK( here.get_field_age( second, fd_blood ) == 3_turns );
+        CHECK( here.get_field_age( far_away, fd_blood ) == 3_turns );
+    }
+
+    SECTION( "removed fields are dropped and new ones picked up" ) {
+        here.remove_field( first, fd_blood );
+        here.process_fields();
+        here.add_field( first, fd_blood, 1, 1_turns );
+        here.process_fields();
+        CHECK( here.get_field_age( first, fd_blood ) == 2_turns );
+        CHECK( here.get_field_age( second, fd_blood ) == 3_turns );
+    }
+}
+
+// Intensities of smoke around a cloud big enough for its spreads to be picked in several batches
+static std::vector<int> spread_smoke_cloud( unsigned int seed )
+{
+    clear_all_state();
+    map &here = get_map();
+    for( int x = 40; x < 60; x++ ) {
+        for( int y = 40; y < 60; y++ ) {
+            here.add_field( tripoint( x, y, 0 ), fd_smoke, 3, 1_turns );
+        }
+    }
+    rng_set_engine_seed( seed );
+    for( int turn = 0; turn < 5; turn++ ) {
+        here.process_fields();
+    }
+    std::vector<int> intensities;
+    for( int x = 30; x < 70; x++ ) {
+        for( int y = 30; y < 70; y++ ) {
+            intensities.push_back( here.get_field_intensity( tripoint( x, y, 0 ), fd_smoke ) );
+        }
+    }
+    return intensities;
+}
+
+TEST_CASE( "parallel_gas_spread_is_reproducible", "[field]" )
+{
+    restore_on_out_of_scope<bool> restore_spread( parallel_field_spread );
+    parallel_field_spread = true;
+
+    const std::vector<int> first = spread_smoke_cloud( 1234 );
+    const std::vector<int> second = spread_smoke_cloud( 1234 );
+    CHECK( first == second );
+
+    // Some of the smoke made it out of the square it started in
+    int spread_out = 0;
+    for( int x = 30; x < 70; x++ ) {
+        for( int y = 30; y < 70; y++ ) {
+            const bool outside = x < 40 || x >= 60 || y < 40 || y >= 60;
+            if( outside && first[( x - 30 ) * 40 + y - 30] > 0 ) {
+                spread_out++;
+            }
+        }
+    }
+    CHECK( spread_out > 0 );
+}
@@ -5,6 +5,7 @@
 #include <sstream>
 #include <string>
 
+#include "fstream_utils.h"
 #include "game_constants.h"
 #include "json.h"
 #include "lru_cache.h"
@@ -41,8 +42,8 @@ TEST_CASE( "map_memory_defaults", "[map_memory]" )
     map_memory memory;
     memory.prepare_region( p1, p2 );
     CHECK( memory.get_symbol( p1 ) == 0 );
-    memorized_terrain_tile default_tile = memory.get_tile( p1 );
-    CHECK( default_tile.tile.empty() );
+    const mm_packed_tile default_tile = memory.get_tile( p1 );
+    CHECK( default_tile.name().empty() );
     CHECK( default_tile.subtile == 0 );
     CHECK( default_tile.rotation == 0 );
 }
@@ -75,7 +76,85 @@ TEST_CASE( "map_memory_forgets", "[map_memory]" )
     memory.memorize_symbol( p3, 1 );
 }
 
-// TODO: map memory save / load
+static void check_tile( const mm_packed_tile &actual, const std::string &name, int subtile,
+                        int rotation )
+{
+    CHECK( actual.name() == name );
+    CHECK( actual.subtile == subtile );
+    CHECK( actual.rotation == rotation );
+}
+
+TEST_CASE( "map_memory_remembers_tiles", "[map_memory]" )
+{
+    map_memory memory;
+    memory.prepare_region( p1, p2 );
+    memory.memorize_tile( p1, "t_floor", 1, 90 );
+    memory.memorize_tile( p2, "vp_frame_vertical_2", 0, 270 );
+    check_tile( memory.get_tile( p1 ), "t_floor", 1, 90 );
+    check_tile( memory.get_tile( p2 ), "vp_frame_vertical_2", 0, 270 );
+
+    memory.memorize_tile( p1, "t_wall", 0, 0 );
+    check_tile( memory.get_tile( p1 ), "t_wall", 0, 0 );
+    memory.clear_memorized_tile( p2 );
+    CHECK( memory.get_tile( p2 ) == mm_packed_tile() );
+}
+
+TEST_CASE( "map_memory_tile_names_stay_valid", "[map_memory]" )
+{
+    const uint32_t id = memorized_tile_ids::intern( "vp_frame_vertical_2" );
+    const std::string &name = memorized_tile_ids::name( id );
+    for( int i = 0; i < 10000; i++ ) {
+        memorized_tile_ids::intern( string_format( "test_tile_name_%d", i ) );
+    }
+    CHECK( &name == &memorized_tile_ids::name( id ) );
+    CHECK( name == "vp_frame_vertical_2" );
+}
+
+static void check_same_submaps( const mm_submap &expected, const mm_submap &actual )
+{
+    for( int y = 0; y < SEEY; y++ ) {
+        for( int x = 0; x < SEEX; x++ ) {
+            const point p( x, y );
+            CAPTURE( p );
+            CHECK( actual.packed_tile( p ) == expected.packed_tile( p ) );
+            CHECK( actual.symbol( p ) == expected.symbol( p ) );
+        }
+    }
+}
+
+TEST_CASE( "map_memory_submap_save_load", "[map_memory]" )
+{
+    mm_submap sm;
+    for( int x = 0; x < SEEX; x++ ) {
+        sm.set_tile( point( x, 2 ), memorized_terrain_tile{ "t_wall", x % 3, 0 } );
+        sm.set_tile( point( x, 3 ), memorized_terrain_tile{ "t_floor", 0, 0 } );
+    }
+    sm.set_tile( point( 5, 7 ), memorized_terrain_tile{ "vp_seat", 1, 45 } );
+    sm.set_symbol( point( 5, 7 ), '#' );
+    sm.set_symbol( point( 0, 0 ), '.' );
+
+    const std::string saved = serialize( sm );
+    // Names are only saved once
+    CHECK( saved.find( "t_floor" ) == saved.rfind( "t_floor" ) );
+
+    mm_submap loaded;
+    deserialize( loaded, saved );
+    check_same_submaps( sm, loaded );
+}
+
+TEST_CASE( "map_memory_submap_loads_legacy_format", "[map_memory]" )
+{
+    mm_submap expected;
+    expected.set_tile( point( 0, 0 ), memorized_terrain_tile{ "t_floor", 0, 0 } );
+    expected.set_tile( point( 1, 0 ), memorized_terrain_tile{ "t_floor", 0, 0 } );
+    expected.set_symbol( point( 1, 0 ), '.' );
+
+    const std::string legacy = string_format( R"([["t_floor",0,0,0],["t_floor",0,0,46],)"
+                               R"(["",0,0,0,%d]])", SEEX * SEEY - 2 );
+    mm_submap loaded;
+    deserialize( loaded, legacy );
+    check_same_submaps( expected, loaded );
+}
 
 #include <chrono>
 
@@ -0,0 +1,107 @@
+#include "catch/catch.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "map_quad_prefetcher.h"
+
+namespace
+{
+
+// Stands in for the database: records what was read, and can hold the worker inside a read
+struct fake_quads {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::string> fetched;
+    bool held = false;
+
+    map_quad_prefetcher::fetch_fn fetch() {
+        return [this]( const std::string & path ) -> std::optional<std::string> {
+            std::unique_lock<std::mutex> lk( mutex );
+            fetched.push_back( path );
+            cv.notify_all();
+            cv.wait( lk, [this] {
+                return !held;
+            } );
+            if( path.starts_with( "missing" ) ) {
+                return std::nullopt;
+            }
+            return "contents of " + path;
+        };
+    }
+
+    void wait_for_fetches( size_t count ) {
+        std::unique_lock<std::mutex> lk( mutex );
+        cv.wait( lk, [this, count] {
+            return fetched.size() >= count;
+        } );
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lk( mutex );
+            held = false;
+        }
+        cv.notify_all();
+    }
+};
+
+} // namespace
+
+TEST_CASE( "prefetched_map_quads_are_handed_over_once", "[world]" )
+{
+    fake_quads quads;
+    map_quad_prefetcher prefetcher( quads.fetch() );
+    prefetcher.request( { "1.1.0.map", "missing.map" } );
+    prefetcher.wait_idle();
+
+    bool found = false;
+    std::string data;
+    REQUIRE( prefetcher.take( "1.1.0.map", found, data ) );
+    CHECK( found );
+    CHECK( data == "contents of 1.1.0.map" );
+
+    REQUIRE( prefetcher.take( "missing.map", found, data ) );
+    CHECK_FALSE( found );
+
+    // Handed over already, the caller has to read it itself now
+    CHECK_FALSE( prefetcher.take( "1.1.0.map", found, data ) );
+    CHECK_FALSE( prefetcher.take( "2.2.0.map", found, data ) );
+}
+
+TEST_CASE( "prefetched_map_quads_are_dropped_when_written", "[world]" )
+{
+    fake_quads quads;
+    map_quad_prefetcher prefetcher( quads.fetch() );
+    prefetcher.request( { "1.1.0.map" } );
+    prefetcher.wait_idle();
+
+    prefetcher.invalidate( "1.1.0.map" );
+    bool found = false;
+    std::string data;
+    CHECK_FALSE( prefetcher.take( "1.1.0.map", found, data ) );
+}
+
+TEST_CASE( "moving_cancels_unread_prefetch_requests", "[world]" )
+{
+    fake_quads quads;
+    quads.held = true;
+    map_quad_prefetcher prefetcher( quads.fetch() );
+    prefetcher.request( { "1.1.0.map", "1.2.0.map", "1.3.0.map" } );
+    quads.wait_for_fetches( 1 );
+
+    // The player turned around while the first quad was being read
+    prefetcher.request( { "1.1.0.map", "0.1.0.map" } );
+    quads.release();
+    prefetcher.wait_idle();
+
+    CHECK( quads.fetched == std::vector<std::string> { "1.1.0.map", "0.1.0.map" } );
+    bool found = false;
+    std::string data;
+    CHECK( prefetcher.take( "1.1.0.map", found, data ) );
+    CHECK( prefetcher.take( "0.1.0.map", found, data ) );
+    CHECK_FALSE( prefetcher.take( "1.2.0.map", found, data ) );
+}
@@ -0,0 +1,138 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <vector>
+
+#include "game_constants.h"
+#include "line.h"
+#include "map.h"
+#include "mapdata.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "trap.h"
+
+// Splits the map in two with a wall along `x`, leaving only `gap` open
+static void build_wall_with_gap( map &here, const tripoint &gap )
+{
+    for( int y = 0; y < MAPSIZE_Y; y++ ) {
+        here.ter_set( tripoint( gap.x, y, gap.z ), t_wall );
+    }
+    here.ter_set( gap, t_floor );
+}
+
+static bool route_passes( const tripoint &from, const tripoint &to,
+                          const PathfindingSettings &settings, const tripoint &p )
+{
+    const std::vector<tripoint> path = Pathfinding::route( from, to, settings, RouteSettings() );
+    return !path.empty() && std::ranges::find( path, p ) != path.end();
+}
+
+TEST_CASE( "cached_d_maps_follow_tile_changes", "[pathfind]" )
+{
+    clear_all_state();
+    Pathfinding::clear_d_maps();
+    map &here = get_map();
+    const tripoint from( 50, 60, 0 );
+    const tripoint to( 70, 60, 0 );
+    const tripoint gap( 60, 60, 0 );
+    build_wall_with_gap( here, gap );
+
+    PathfindingSettings settings;
+    settings.trap_cost = INFINITY;
+    // The route below keeps the d_map of `to` cached for the next one
+    REQUIRE( route_passes( from, to, settings, gap ) );
+
+    SECTION( "terrain" ) {
+        here.ter_set( gap, t_wall );
+        CHECK( Pathfinding::route( from, to, settings, RouteSettings() ).empty() );
+        here.ter_set( gap, t_floor );
+        CHECK( route_passes( from, to, settings, gap ) );
+    }
+
+    SECTION( "furniture" ) {
+        here.furn_set( gap, f_rack );
+        CHECK( Pathfinding::route( from, to, settings, RouteSettings() ).empty() );
+        here.furn_set( gap, f_null );
+        CHECK( route_passes( from, to, settings, gap ) );
+    }
+
+    SECTION( "trap" ) {
+        here.trap_set( gap, tr_beartrap );
+        CHECK( Pathfinding::route( from, to, settings, RouteSettings() ).empty() );
+        here.remove_trap( gap );
+        CHECK( route_passes( from, to, settings, gap ) );
+    }
+
+    Pathfinding::clear_d_maps();
+}
+
+TEST_CASE( "flow_step_follows_the_route", "[pathfind]" )
+{
+    clear_all_state();
+    Pathfinding::clear_d_maps();
+    map &here = get_map();
+    const tripoint to( 70, 60, 0 );
+    const tripoint gap( 60, 60, 0 );
+    build_wall_with_gap( here, gap );
+    const PathfindingSettings settings;
+    const RouteSettings route_settings;
+
+    // Straight at the gap, then a diagonal run that only has one shortest way to it
+    for( const tripoint &from : { tripoint( 50, 60, 0 ), tripoint( 40, 40, 0 ) } ) {
+        CAPTURE( from );
+        const std::optional<tripoint> step = Pathfinding::flow_step( from, to, settings,
+                                             route_settings );
+        REQUIRE( step );
+        CHECK( square_dist( *step, from ) == 1 );
+        CHECK( rl_dist( *step, to ) < rl_dist( from, to ) );
+
+        const std::vector<tripoint> path = Pathfinding::route( from, to, settings, route_settings );
+        REQUIRE( path.size() > 1 );
+        CHECK( *step == path[1] );
+    }
+
+    // Nothing to step towards on the other side of a closed wall
+    here.ter_set( gap, t_wall );
+    CHECK_FALSE( Pathfinding::flow_step( tripoint( 50, 60, 0 ), to, settings, route_settings ) );
+
+    Pathfinding::clear_d_maps();
+}
+
+TEST_CASE( "flow_step_respects_the_f_limit", "[pathfind]" )
+{
+    clear_all_state();
+    Pathfinding::clear_d_maps();
+    map &here = get_map();
+    const tripoint from( 50, 30, 0 );
+    const tripoint to( 70, 30, 0 );
+    // The only way through is far off the straight line, outside the search radius and cone
+    build_wall_with_gap( here, tripoint( 60, 60, 0 ) );
+    const PathfindingSettings settings;
+
+    RouteSettings route_settings;
+    route_settings.search_radius_coeff = 1.0;
+    route_settings.search_cone_angle = 30.0;
+    route_settings.f_limit_based_on_max_dist = false;
+
+    SECTION( "detour costs more than the limit" ) {
+        route_settings.max_f_coeff = 2.0;
+        CHECK_FALSE( Pathfinding::flow_step( from, to, settings, route_settings ) );
+        CHECK( Pathfinding::route( from, to, settings, route_settings ).empty() );
+    }
+
+    SECTION( "detour is within the limit" ) {
+        route_settings.max_f_coeff = 10.0;
+        CHECK( Pathfinding::flow_step( from, to, settings, route_settings ) );
+        CHECK_FALSE( Pathfinding::route( from, to, settings, route_settings ).empty() );
+    }
+
+    // Without a search radius and cone the f-limit doesn't apply
+    route_settings.max_f_coeff = 2.0;
+    route_settings.search_radius_coeff = INFINITY;
+    CHECK( Pathfinding::flow_step( from, to, settings, route_settings ) );
+
+    Pathfinding::clear_d_maps();
+}
@@ -204,3 +204,35 @@ TEST_CASE( "Items don't rot away on map load if in a freezer" )
     auto normal_stack_after = m.i_at( normal_pnt );
     REQUIRE( normal_stack_after.empty() );
 }
+
+TEST_CASE( "Items catching up on rot share weather temperatures" )
+{
+    weather_manager weather;
+    if( calendar::turn <= calendar::start_of_cataclysm ) {
+        calendar::turn = calendar::start_of_cataclysm + 1_minutes;
+    }
+    detached_ptr<item> first = item::process( item::spawn( "meat_cooked" ), nullptr,
+                               tripoint_zero, false, temperature_flag::TEMP_NORMAL, weather );
+    detached_ptr<item> second = item::process( item::spawn( "meat_cooked" ), nullptr,
+                                tripoint_zero, false, temperature_flag::TEMP_NORMAL, weather );
+
+    calendar::turn += 3_days;
+    first = item::process_rot( std::move( first ), true, tripoint_zero, nullptr,
+                               temperature_flag::TEMP_NORMAL, weather );
+    const size_t cached = weather.cached_weather_temperatures();
+    CHECK( cached > 0 );
+    second = item::process_rot( std::move( second ), true, tripoint_zero, nullptr,
+                                temperature_flag::TEMP_NORMAL, weather );
+    CHECK( weather.cached_weather_temperatures() == cached );
+    CHECK( first->get_rot() == second->get_rot() );
+
+    // Anywhere on the same overmap tile during the same hour reads the same temperature
+    const tripoint_abs_ms location( get_map().getabs( tripoint_zero ) );
+    const tripoint_abs_ms corner( project_to<coords::ms>( project_to<coords::omt>( location ) ) );
+    const time_point hour = calendar::turn_zero + time_duration::from_hours( to_hours<int>(
+                                calendar::turn - 1_days - calendar::turn_zero ) );
+    const units::temperature expected = weather.get_cur_weather_gen().get_weather_temperature(
+                                            corner, hour, calendar::config, g->get_seed() );
+    CHECK( weather.get_weather_temperature( location, hour + 59_minutes ) == expected );
+    CHECK( weather.get_weather_temperature( corner + point( 5, 7 ), hour ) == expected );
+}
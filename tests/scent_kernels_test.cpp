@@ -0,0 +1,96 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "scent_kernels.h"
+
+namespace
+{
+
+// A column of the scent radius plus a few, so the kernels also have to handle a partial last batch
+constexpr int num_tiles = 83;
+
+struct random_column {
+    // One extra tile before and after, read by column_sums
+    std::vector<char> transfer;
+    std::vector<int> scent;
+
+    random_column() : transfer( num_tiles + 2 ), scent( num_tiles + 2 ) {
+        std::mt19937 rng( 42 );
+        std::uniform_int_distribution<int> kind( 0, 9 );
+        std::uniform_int_distribution<int> value( -50, 10000 );
+        for( int i = 0; i < num_tiles + 2; ++i ) {
+            const int k = kind( rng );
+            transfer[i] = k == 0 ? 0 : k == 1 ? 1 : 5;
+            scent[i] = k < 4 ? 0 : value( rng );
+        }
+    }
+};
+
+} // namespace
+
+TEST_CASE( "scent_kernels_match_scalar_versions", "[scent]" )
+{
+    random_column column;
+    const char *transfer = column.transfer.data() + 1;
+    const int *scent = column.scent.data() + 1;
+
+    std::vector<int> sum( num_tiles );
+    std::vector<int> used( num_tiles );
+    std::vector<int> reference_sum( num_tiles );
+    std::vector<int> reference_used( num_tiles );
+    scent_kernels::column_sums( transfer, scent, sum.data(), used.data(), num_tiles );
+    scent_kernels::scalar::column_sums( transfer, scent, reference_sum.data(),
+                                        reference_used.data(), num_tiles );
+    CHECK( sum == reference_sum );
+    CHECK( used == reference_used );
+
+    std::vector<int> total( num_tiles );
+    std::vector<int> reference_total( num_tiles );
+    std::vector<int> reversed( sum.rbegin(), sum.rend() );
+    scent_kernels::add_columns( reversed.data(), sum.data(), scent, total.data(), num_tiles );
+    scent_kernels::scalar::add_columns( reversed.data(), sum.data(), scent,
+                                        reference_total.data(), num_tiles );
+    CHECK( total == reference_total );
+
+    // Three columns worth of squares used, minus the odd vehicle hole
+    for( int i = 0; i < num_tiles; ++i ) {
+        used[i] = std::max( 0, used[i] * 3 - ( i % 7 == 0 ? 4 : 0 ) );
+    }
+    std::vector<int> fast( num_tiles );
+    std::vector<int> reference( num_tiles );
+    scent_kernels::diffuse( transfer, scent, total.data(), used.data(), fast.data(), num_tiles );
+    scent_kernels::scalar::diffuse( transfer, scent, total.data(), used.data(), reference.data(),
+                                    num_tiles );
+    CHECK( fast == reference );
+}
+
+TEST_CASE( "bench_scent_kernels", "[scent][benchmark][.]" )
+{
+    random_column column;
+    const char *transfer = column.transfer.data() + 1;
+    const int *scent = column.scent.data() + 1;
+    std::vector<int> sum( num_tiles );
+    std::vector<int> used( num_tiles );
+    std::vector<int> out( num_tiles );
+
+    BENCHMARK( "column_sums" ) {
+        scent_kernels::column_sums( transfer, scent, sum.data(), used.data(), num_tiles );
+        return sum[0];
+    };
+    BENCHMARK( "column_sums (scalar)" ) {
+        scent_kernels::scalar::column_sums( transfer, scent, sum.data(), used.data(), num_tiles );
+        return sum[0];
+    };
+    BENCHMARK( "diffuse" ) {
+        scent_kernels::diffuse( transfer, scent, sum.data(), used.data(), out.data(), num_tiles );
+        return out[0];
+    };
+    BENCHMARK( "diffuse (scalar)" ) {
+        scent_kernels::scalar::diffuse( transfer, scent, sum.data(), used.data(), out.data(),
+                                        num_tiles );
+        return out[0];
+    };
+}
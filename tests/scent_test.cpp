@@ -1,6 +1,9 @@
 
 #include "scent_map.h"
 #include "catch/catch.hpp"
+
+#include <vector>
+
 #include "map.h"
 #include "map_helpers.h"
 #include "game.h"
@@ -170,3 +173,106 @@ TEST_CASE( "scent_matches_old", "[.]" )
     }
 }
 
+
+static const scenttype_id sc_human( "sc_human" );
+
+// Resets the scent map, lays scent on `sources` and lets it spread for `turns` updates
+static std::vector<int> spread_scent( const tripoint &center, const std::vector<tripoint> &sources,
+                                      int turns )
+{
+    g->scent.reset();
+    for( const tripoint &p : sources ) {
+        g->scent.set( p, 1000, sc_human );
+    }
+    for( int i = 0; i < turns; i++ ) {
+        g->scent.update( center, get_map() );
+    }
+    std::vector<int> result;
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            result.push_back( g->scent.get( { x, y, center.z } ) );
+        }
+    }
+    return result;
+}
+
+static void set_wall_column( map &here, int x, const ter_id &ter )
+{
+    for( int y = 0; y < MAPSIZE_Y; y++ ) {
+        here.ter_set( tripoint( x, y, 0 ), ter );
+    }
+}
+
+TEST_CASE( "scent_update_skips_only_areas_without_scent", "[scent]" )
+{
+    clear_all_state();
+    const tripoint origin( 60, 60, 0 );
+    g->place_player( origin );
+    map &here = get_map();
+    here.ter_set( tripoint( 42, 50, 0 ), t_brick_wall );
+
+    // Far enough apart that their scent can't meet in this many turns
+    const int turns = 5;
+    const tripoint a( 40, 50, 0 );
+    const tripoint b( 85, 75, 0 );
+
+    REQUIRE( spread_scent( origin, {}, turns ) == std::vector<int>( MAPSIZE_X * MAPSIZE_Y, 0 ) );
+
+    // Each source on its own only diffuses the area around itself, both together diffuse
+    //   everything between them. Either way, the scent has to come out the same.
+    const std::vector<int> both = spread_scent( origin, { a, b }, turns );
+    const std::vector<int> only_a = spread_scent( origin, { a }, turns );
+    const std::vector<int> only_b = spread_scent( origin, { b }, turns );
+    CHECK( only_a[( a.x + 1 ) * MAPSIZE_Y + a.y] > 0 );
+    CHECK( only_b[( b.x + 1 ) * MAPSIZE_Y + b.y] > 0 );
+    int mismatches = 0;
+    for( size_t i = 0; i < both.size(); i++ ) {
+        mismatches += both[i] != only_a[i] + only_b[i];
+    }
+    CHECK( mismatches == 0 );
+}
+
+TEST_CASE( "scent_transfer_cache_follows_blockers", "[scent]" )
+{
+    clear_all_state();
+    const tripoint origin( 60, 60, 0 );
+    g->place_player( origin );
+    map &here = get_map();
+    const int turns = 10;
+    const tripoint beyond_wall( 63, 60, 0 );
+
+    // Fills the transfer cache around the player before the terrain changes
+    spread_scent( origin, { origin }, turns );
+    REQUIRE( g->scent.get( beyond_wall ) > 0 );
+
+    set_wall_column( here, 62, t_wall );
+    spread_scent( origin, { origin }, turns );
+    CHECK( g->scent.get( beyond_wall ) == 0 );
+
+    set_wall_column( here, 62, t_floor );
+    spread_scent( origin, { origin }, turns );
+    CHECK( g->scent.get( beyond_wall ) > 0 );
+}
+
+TEST_CASE( "scent_transfer_cache_follows_blockers_outside_scent", "[scent]" )
+{
+    clear_all_state();
+    const tripoint origin( 60, 60, 0 );
+    g->place_player( origin );
+    map &here = get_map();
+    const int turns = 10;
+    const tripoint far_source( 90, 60, 0 );
+    const tripoint beyond_wall( 93, 60, 0 );
+
+    // Fill the transfer cache around the far source, then move the scent away from it
+    spread_scent( origin, { far_source }, turns );
+    REQUIRE( g->scent.get( beyond_wall ) > 0 );
+    spread_scent( origin, { origin }, turns );
+
+    // Nothing diffuses near the wall while it goes up
+    set_wall_column( here, 92, t_wall );
+    spread_scent( origin, { origin }, turns );
+
+    spread_scent( origin, { far_source }, turns );
+    CHECK( g->scent.get( beyond_wall ) == 0 );
+}
@@ -1,6 +1,8 @@
 #include "catch/catch.hpp"
 
 #include "submap.h"
+#include "binary_io.h"
+#include "calendar.h"
 #include "game_constants.h"
 #include "int_id.h"
 #include "point.h"
@@ -90,3 +92,85 @@ TEST_CASE( "submap rotation", "[submap]" )
         }
     }
 }
+
+TEST_CASE( "submap binary round trip", "[submap][savegame]" )
+{
+    submap sm( tripoint_zero );
+    sm.last_touched = calendar::turn_zero + 5_days;
+    sm.set_temperature( -3 );
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            sm.set_ter( { x, y }, ter_id( 1 + ( x + y ) % 3 ) );
+            sm.set_radiation( { x, y }, y < SEEY / 2 ? 0 : x - 5 );
+        }
+    }
+    sm.set_furn( { 3, 4 }, furn_id( 1 ) );
+    sm.set_trap( { 5, 6 }, trap_id( 1 ) );
+
+    cata::binary_writer out;
+    sm.store_binary( out );
+
+    submap loaded( tripoint_zero );
+    cata::binary_reader in( out.data() );
+    loaded.load_binary( in, 0, tripoint_zero );
+    CHECK( in.eof() );
+
+    CHECK( loaded.last_touched == sm.last_touched );
+    CHECK( loaded.get_temperature() == -3 );
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            const point p( x, y );
+            CAPTURE( p );
+            CHECK( loaded.get_ter( p ) == sm.get_ter( p ) );
+            CHECK( loaded.get_furn( p ) == sm.get_furn( p ) );
+            CHECK( loaded.get_trap( p ) == sm.get_trap( p ) );
+            CHECK( loaded.get_radiation( p ) == sm.get_radiation( p ) );
+        }
+    }
+}
+
+TEST_CASE( "truncated submap binary data is rejected", "[submap][savegame]" )
+{
+    submap sm( tripoint_zero );
+    cata::binary_writer out;
+    sm.store_binary( out );
+
+    const std::string truncated = out.data().substr( 0, out.data().size() / 2 );
+    submap loaded( tripoint_zero );
+    cata::binary_reader in( truncated );
+    CHECK_THROWS( loaded.load_binary( in, 0, tripoint_zero ) );
+}
+
+// Writes a submap whose only radiation run covers `radiation_cells` cells
+static std::string submap_binary_with_radiation( int radiation_cells )
+{
+    cata::binary_writer out;
+    out.write_signed( 0 );
+    out.write_signed( 0 );
+    for( const char *null_id : { "t_null", "f_null", "tr_null" } ) {
+        out.write_varint( 1 );
+        out.write_string( null_id );
+        out.write_varint( 1 );
+        out.write_varint( 0 );
+        out.write_varint( SEEX * SEEY );
+    }
+    out.write_varint( 1 );
+    out.write_signed( 7 );
+    out.write_varint( radiation_cells );
+    out.write_string( "{}" );
+    return out.data();
+}
+
+TEST_CASE( "incomplete submap radiation data is rejected", "[submap][savegame]" )
+{
+    const std::string complete = submap_binary_with_radiation( SEEX * SEEY );
+    submap loaded( tripoint_zero );
+    cata::binary_reader complete_in( complete );
+    loaded.load_binary( complete_in, 0, tripoint_zero );
+    CHECK( loaded.get_radiation( point( SEEX - 1, SEEY - 1 ) ) == 7 );
+
+    const std::string incomplete = submap_binary_with_radiation( SEEX * SEEY - 1 );
+    cata::binary_reader incomplete_in( incomplete );
+    CHECK_THROWS_WITH( loaded.load_binary( incomplete_in, 0, tripoint_zero ),
+                       "submap radiation data is corrupt" );
+}
@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "avatar.h"
+#include "cached_options.h"
 #include "calendar.h"
 #include "catch/catch.hpp"
 #include "color.h"
@@ -282,6 +283,8 @@ int main( int argc, const char *argv[] )
 
     const bool dont_save = check_remove_flags( arg_vec, { "-D", "--drop-world" } );
 
+    skip_verified_data_checks = check_remove_flags( arg_vec, { "--skip-verified-data-checks" } );
+
     std::string user_dir = extract_user_dir( arg_vec );
 
     std::string error_fmt = extract_argument( arg_vec, "--error-format=" );
@@ -303,6 +306,9 @@ int main( int argc, const char *argv[] )
         cata_printf( "                               Don't use any existing folder you care about,\n" );
         cata_printf( "                               all contents will be erased!\n" );
         cata_printf( "  -D, --drop-world             Don't save the world on test failure.\n" );
+        cata_printf( "  --skip-verified-data-checks  Skip the consistency checks of game data that\n" );
+        cata_printf( "                               already passed them in this run.  user_dir is\n" );
+        cata_printf( "                               wiped on start, so the first load still checks.\n" );
         cata_printf( "  --option_overrides=n:v[,…]   Name-value pairs of game options for tests.\n" );
         cata_printf( "                               (overrides config/options.json values)\n" );
         cata_printf( "  --error-format=<value>       Format of error messages.  Possible values are:\n" );
@@ -0,0 +1,35 @@
+#include "catch/catch.hpp"
+
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "thread_pool.h"
+
+TEST_CASE( "thread_pool_runs_every_job", "[thread_pool]" )
+{
+    thread_pool pool( 3 );
+    REQUIRE( pool.size() == 3 );
+
+    std::vector<std::future<int>> results;
+    for( int i = 0; i < 100; i++ ) {
+        results.push_back( pool.submit( [i]() {
+            return i * i;
+        } ) );
+    }
+
+    int sum = 0;
+    for( std::future<int> &f : results ) {
+        sum += f.get();
+    }
+    CHECK( sum == 328350 );
+}
+
+TEST_CASE( "thread_pool_propagates_exceptions", "[thread_pool]" )
+{
+    std::future<int> result = get_thread_pool().submit( []() -> int {
+        throw std::runtime_error( "job failed" );
+    } );
+    CHECK_THROWS_AS( result.get(), std::runtime_error );
+}
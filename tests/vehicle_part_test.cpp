@@ -1,8 +1,12 @@
 #include "catch/catch.hpp"
 
+#include <algorithm>
 #include <array>
+#include <map>
+#include <vector>
 
 #include "damage.h"
+#include "requirements.h"
 #include "type_id.h"
 #include "state_helpers.h"
 #include "veh_type.h"
@@ -15,3 +19,21 @@ TEST_CASE( "verify_copy_from_gets_damage_reduction", "[vehicle]" )
     const vpart_info &vp = vpart_id( "halfboard_horizontal" ).obj();
     CHECK( vp.damage_reduction.type_resist( DT_BASH ) != 0 );
 }
+
+TEST_CASE( "vehicle_parts_are_installed_from_their_base_item", "[vehicle]" )
+{
+    // Set up when the data is finalized, so it holds even when the consistency checks are skipped
+    for( const std::pair<const vpart_id, vpart_info> &e : vpart_info::all() ) {
+        const vpart_info &vp = e.second;
+        CAPTURE( vp.get_id().str() );
+        const requirement_data reqs = vp.install_requirements();
+        const bool needs_base_item = std::ranges::any_of( reqs.get_components(),
+        [&vp]( const std::vector<item_comp> &alternatives ) {
+            return std::ranges::any_of( alternatives, [&vp]( const item_comp & comp ) {
+                return comp.type == vp.item;
+            } );
+        } );
+        CHECK( needs_base_item );
+        CHECK( vp.removal_moves >= 0 );
+    }
+}
@@ -0,0 +1,90 @@
+#include "catch/catch.hpp"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "filesystem.h"
+#include "fstream_utils.h"
+#include "init.h"
+#include "mod_manager.h"
+#include "path_info.h"
+
+static void write_data_file( const std::string &path, const std::string &contents )
+{
+    write_to_file( path, [&contents]( std::ostream & fout ) {
+        fout << contents;
+    }, "" );
+}
+
+// Runs the test against an empty list of verified data, and puts the real one back afterwards
+class verified_data_backup
+{
+    private:
+        std::string contents;
+    public:
+        verified_data_backup() {
+            if( file_exist( PATH_INFO::verified_data() ) ) {
+                contents = read_entire_file( PATH_INFO::verified_data() );
+                remove_file( PATH_INFO::verified_data() );
+            }
+        }
+        ~verified_data_backup() {
+            remove_file( PATH_INFO::verified_data() );
+            if( !contents.empty() ) {
+                write_data_file( PATH_INFO::verified_data(), contents );
+            }
+        }
+};
+
+TEST_CASE( "verified_data_fingerprint_matches_unchanged_data", "[init]" )
+{
+    verified_data_backup backup;
+    const std::vector<mod_id> packs = { mod_management::get_default_core_content_pack() };
+    const size_t fingerprint = init::data_fingerprint( packs );
+    CHECK( fingerprint == init::data_fingerprint( packs ) );
+
+    CHECK_FALSE( init::is_data_verified( fingerprint ) );
+    init::mark_data_verified( fingerprint );
+    CHECK( init::is_data_verified( fingerprint ) );
+}
+
+TEST_CASE( "verified_data_fingerprint_changes_with_data", "[init]" )
+{
+    verified_data_backup backup;
+    const std::string dir = PATH_INFO::user_dir() + "fingerprint_test/";
+    REQUIRE( assure_dir_exist( dir ) );
+    write_data_file( dir + "a.json", R"([{"type":"test"}])" );
+
+    const size_t fingerprint = init::files_fingerprint( dir );
+    init::mark_data_verified( fingerprint );
+    REQUIRE( init::is_data_verified( fingerprint ) );
+
+    SECTION( "edited file" ) {
+        write_data_file( dir + "a.json", R"([{"type":"test","edited":true}])" );
+        const size_t edited = init::files_fingerprint( dir );
+        CHECK( edited != fingerprint );
+        CHECK_FALSE( init::is_data_verified( edited ) );
+    }
+
+    SECTION( "added file" ) {
+        write_data_file( dir + "b.json", "[]" );
+        const size_t added = init::files_fingerprint( dir );
+        CHECK( added != fingerprint );
+        CHECK_FALSE( init::is_data_verified( added ) );
+    }
+
+    SECTION( "removed file" ) {
+        remove_file( dir + "a.json" );
+        const size_t removed = init::files_fingerprint( dir );
+        CHECK( removed != fingerprint );
+        CHECK_FALSE( init::is_data_verified( removed ) );
+    }
+
+    SECTION( "different mod list" ) {
+        const mod_id core = mod_management::get_default_core_content_pack();
+        CHECK( init::data_fingerprint( { core } ) != init::data_fingerprint( {} ) );
+    }
+
+    remove_tree( dir );
+}
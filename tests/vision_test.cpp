@@ -717,3 +717,34 @@ TEST_CASE( "vision_see_into_vehicle", "[shadowcasting][vision]" )
 
     t.test();
 }
+
+TEST_CASE( "vision_cached_light_follows_changes_around_it", "[shadowcasting][vision]" )
+{
+    clear_all_state();
+    const ter_id t_brick_wall( "t_brick_wall" );
+    const ter_id t_dirt( "t_dirt" );
+    const ter_id t_utility_light( "t_utility_light" );
+    map &here = get_map();
+    calendar::turn = midnight;
+
+    const tripoint lamp( 60, 65, 0 );
+    const tripoint behind_wall = lamp + point( 0, 4 );
+    here.ter_set( lamp, t_utility_light );
+    here.build_map_cache( lamp.z );
+    const float lit = here.ambient_light_at( behind_wall );
+    REQUIRE( lit > LIGHT_AMBIENT_LOW );
+
+    // The light cast last turn has to be thrown away once a wall goes up in its way...
+    for( int x = -3; x <= 3; x++ ) {
+        here.ter_set( lamp + point( x, 2 ), t_brick_wall );
+    }
+    here.build_map_cache( lamp.z );
+    CHECK( here.ambient_light_at( behind_wall ) < lit );
+
+    // ...and comes back the same once it's gone.
+    for( int x = -3; x <= 3; x++ ) {
+        here.ter_set( lamp + point( x, 2 ), t_dirt );
+    }
+    here.build_map_cache( lamp.z );
+    CHECK( here.ambient_light_at( behind_wall ) == Approx( lit ) );
+}